@@ -0,0 +1,201 @@
+/**
+ * @file bench_limbs.c
+ * @brief Benchmark of limb storage against the char-per-digit layout
+ *
+ * Times the "parse a huge decimal, do one add or multiply, print it in
+ * decimal" workload twice: once on the library's limb representation
+ * (binary or base 10^18, depending on ARBITRARY_INT_DECIMAL_LIMBS), and
+ * once on a reference copy of the old char-per-digit layout, where every
+ * kernel step handles a single ASCII digit.
+ *
+ * Build the project twice (with -DARBITRARY_INT_DECIMAL_LIMBS=ON/OFF)
+ * to compare the two limb modes with each other.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "ArbitraryInt.h"
+
+/**
+ * @brief Char-per-digit addition of two digit strings
+ *
+ * Same algorithm as the original add_absolute: one digit per iteration,
+ * written backwards and then reversed.
+ */
+static char* legacy_add(const char *a, const char *b) {
+    size_t len_a = strlen(a);
+    size_t len_b = strlen(b);
+    size_t max_len = (len_a > len_b) ? len_a : len_b;
+    char *result = calloc(max_len + 2, sizeof(char));
+    if(!result) {
+        return NULL;
+    }
+
+    int carry = 0;
+    for(size_t i = 0; i < max_len; i++) {
+        int digit_a = (i < len_a) ? (a[len_a - 1 - i] - '0') : 0;
+        int digit_b = (i < len_b) ? (b[len_b - 1 - i] - '0') : 0;
+        int sum = digit_a + digit_b + carry;
+        carry = sum / 10;
+        result[i] = (char)(sum % 10 + '0');
+    }
+    size_t len = max_len;
+    if(carry) {
+        result[len++] = (char)(carry + '0');
+    }
+    for(size_t i = 0, j = len - 1; i < j; i++, j--) {
+        char temp = result[i];
+        result[i] = result[j];
+        result[j] = temp;
+    }
+    return result;
+}
+
+/**
+ * @brief Char-per-digit schoolbook multiplication of two digit strings
+ *
+ * One digit product per inner iteration. The original's per-row string
+ * padding and reallocation is left out, so this measures the digit
+ * layout rather than allocator traffic.
+ */
+static char* legacy_multiply(const char *a, const char *b) {
+    size_t len_a = strlen(a);
+    size_t len_b = strlen(b);
+    int *acc = calloc(len_a + len_b, sizeof(int));
+    char *result = malloc(len_a + len_b + 1);
+    if(!acc || !result) {
+        free(acc);
+        free(result);
+        return NULL;
+    }
+
+    for(size_t i = len_a; i-- > 0;) {
+        int carry = 0;
+        int digit_a = a[i] - '0';
+        for(size_t j = len_b; j-- > 0;) {
+            int cur = acc[i + j + 1] + digit_a * (b[j] - '0') + carry;
+            acc[i + j + 1] = cur % 10;
+            carry = cur / 10;
+        }
+        acc[i] += carry;
+    }
+
+    size_t start = 0;
+    while(start + 1 < len_a + len_b && acc[start] == 0) {
+        start++;
+    }
+    size_t len = 0;
+    for(size_t i = start; i < len_a + len_b; i++) {
+        result[len++] = (char)(acc[i] + '0');
+    }
+    result[len] = '\0';
+    free(acc);
+    return result;
+}
+
+/**
+ * @brief Char-per-digit "parse": validate every digit and copy the string
+ */
+static char* legacy_parse(const char *str) {
+    for(const char *p = str; *p; p++) {
+        if(!isdigit((unsigned char)*p)) {
+            return NULL;
+        }
+    }
+    return strdup(str);
+}
+
+/**
+ * @brief Fills a buffer with pseudo-random decimal digits
+ * @param digits Number of digits
+ * @param seed Generator seed
+ * @return Newly allocated digit string without leading zero
+ */
+static char* random_digits(size_t digits, unsigned long seed) {
+    char *str = malloc(digits + 1);
+    if(!str) {
+        return NULL;
+    }
+    for(size_t i = 0; i < digits; i++) {
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        str[i] = (char)('0' + (seed >> 33) % 10);
+    }
+    if(str[0] == '0') {
+        str[0] = '7';
+    }
+    str[digits] = '\0';
+    return str;
+}
+
+static double elapsed_ms(clock_t start) {
+    return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Runs parse + op + print on both layouts and prints one table row
+ * @param digits Operand length in decimal digits
+ * @param multiply true for multiplication, false for addition
+ * @param reps Number of repetitions to average over
+ */
+static void run_case(size_t digits, bool multiply, int reps) {
+    char *a_str = random_digits(digits, 1);
+    char *b_str = random_digits(digits, 2);
+    size_t legacy_len = 0;
+    size_t limb_len = 0;
+
+    clock_t start = clock();
+    for(int r = 0; r < reps; r++) {
+        char *a = legacy_parse(a_str);
+        char *b = legacy_parse(b_str);
+        char *result = multiply ? legacy_multiply(a, b) : legacy_add(a, b);
+        char *printed = strdup(result);
+        legacy_len = strlen(printed);
+        free(a);
+        free(b);
+        free(result);
+        free(printed);
+    }
+    double legacy_ms = elapsed_ms(start) / reps;
+
+    start = clock();
+    for(int r = 0; r < reps; r++) {
+        ArbitraryInt *a = create_arbitrary_int(a_str);
+        ArbitraryInt *b = create_arbitrary_int(b_str);
+        ArbitraryInt *result = multiply ? multiply_arbitrary_ints(a, b) : add_arbitrary_ints(a, b);
+        char *printed = arbitrary_int_to_string(result);
+        limb_len = strlen(printed);
+        free_arbitrary_int(a);
+        free_arbitrary_int(b);
+        free_arbitrary_int(result);
+        free(printed);
+    }
+    double limb_ms = elapsed_ms(start) / reps;
+
+    printf("%-4s %9zu %14.3f %14.3f %9.1fx%s\n",
+           multiply ? "mul" : "add", digits, legacy_ms, limb_ms,
+           limb_ms > 0 ? legacy_ms / limb_ms : 0.0,
+           legacy_len == limb_len ? "" : "  (length mismatch!)");
+
+    free(a_str);
+    free(b_str);
+}
+
+int main() {
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    printf("Limb mode: decimal (base 10^18)\n\n");
+#else
+    printf("Limb mode: binary (base 2^64)\n\n");
+#endif
+    printf("%-4s %9s %14s %14s %10s\n", "op", "digits", "char/digit ms", "limbs ms", "speedup");
+
+    run_case(1000, false, 200);
+    run_case(10000, false, 50);
+    run_case(100000, false, 5);
+    run_case(1000, true, 20);
+    run_case(10000, true, 2);
+
+    return 0;
+}
@@ -43,7 +43,13 @@ int build_with_gcc() {
         "gcc -c src/operations.c -I./include -o build/operations.o",
         "gcc -c src/parser.c -I./include -o build/parser.o",
         "gcc -c src/system_utils.c -I./include -o build/system_utils.o",
-        "gcc -c src/fraction.c -I./include -o build/fraction.o"
+        "gcc -c src/fraction.c -I./include -o build/fraction.o",
+        "gcc -c src/limb_ops.c -I./include -o build/limb_ops.o",
+        "gcc -c src/limb_mul.c -I./include -o build/limb_mul.o",
+        "gcc -c src/limb_ntt.c -I./include -o build/limb_ntt.o",
+        "gcc -c src/limb_div.c -I./include -o build/limb_div.o",
+        "gcc -c src/limb_gcd.c -I./include -o build/limb_gcd.o",
+        "gcc -c src/limb_x86.c -I./include -o build/limb_x86.o"
     };
 
     for (size_t i = 0; i < sizeof(compile_cmds)/sizeof(compile_cmds[0]); i++) {
@@ -63,7 +69,13 @@ int build_with_gcc() {
         " build\\operations.o"
         " build\\parser.o"
         " build\\system_utils.o"
-        " build\\fraction.o";
+        " build\\fraction.o"
+        " build\\limb_ops.o"
+        " build\\limb_mul.o"
+        " build\\limb_ntt.o"
+        " build\\limb_div.o"
+        " build\\limb_gcd.o"
+        " build\\limb_x86.o";
 #else
         "ar rcs build/Release/libcalculator.a"
         " build/ArbitraryInt.o"
@@ -71,7 +83,13 @@ int build_with_gcc() {
         " build/operations.o"
         " build/parser.o"
         " build/system_utils.o"
-        " build/fraction.o";
+        " build/fraction.o"
+        " build/limb_ops.o"
+        " build/limb_mul.o"
+        " build/limb_ntt.o"
+        " build/limb_div.o"
+        " build/limb_gcd.o"
+        " build/limb_x86.o";
 #endif
 
     printf("Creating static library...\n");
@@ -83,9 +101,9 @@ int build_with_gcc() {
     // 4. Compile and link main program
     const char *link_cmd =
 #ifdef _WIN32
-        "gcc src/main.c -L./build/Release -lcalculator -I./include -o build\\Release\\calculator.exe";
+        "gcc src/main.c -L./build/Release -lcalculator -lm -I./include -o build\\Release\\calculator.exe";
 #else
-        "gcc src/main.c -L./build/Release -lcalculator -I./include -o build/Release/calculator";
+        "gcc src/main.c -L./build/Release -lcalculator -lm -I./include -o build/Release/calculator";
 #endif
 
     printf("Linking final executable...\n");
@@ -44,7 +44,13 @@ int build_and_run_tests_with_gcc() {
         "gcc -c src/operations.c -I./include -o build/operations.o",
         "gcc -c src/parser.c -I./include -o build/parser.o",
         "gcc -c src/system_utils.c -I./include -o build/system_utils.o",
-        "gcc -c src/fraction.c -I./include -o build/fraction.o"
+        "gcc -c src/fraction.c -I./include -o build/fraction.o",
+        "gcc -c src/limb_ops.c -I./include -o build/limb_ops.o",
+        "gcc -c src/limb_mul.c -I./include -o build/limb_mul.o",
+        "gcc -c src/limb_ntt.c -I./include -o build/limb_ntt.o",
+        "gcc -c src/limb_div.c -I./include -o build/limb_div.o",
+        "gcc -c src/limb_gcd.c -I./include -o build/limb_gcd.o",
+        "gcc -c src/limb_x86.c -I./include -o build/limb_x86.o"
     };
 
     for (size_t i = 0; i < sizeof(compile_cmds)/sizeof(compile_cmds[0]); i++) {
@@ -64,7 +70,13 @@ int build_and_run_tests_with_gcc() {
         " build\\operations.o"
         " build\\parser.o"
         " build\\system_utils.o"
-        " build\\fraction.o";
+        " build\\fraction.o"
+        " build\\limb_ops.o"
+        " build\\limb_mul.o"
+        " build\\limb_ntt.o"
+        " build\\limb_div.o"
+        " build\\limb_gcd.o"
+        " build\\limb_x86.o";
 #else
         "ar rcs build/Release/libcalculator.a"
         " build/ArbitraryInt.o"
@@ -72,7 +84,13 @@ int build_and_run_tests_with_gcc() {
         " build/operations.o"
         " build/parser.o"
         " build/system_utils.o"
-        " build/fraction.o";
+        " build/fraction.o"
+        " build/limb_ops.o"
+        " build/limb_mul.o"
+        " build/limb_ntt.o"
+        " build/limb_div.o"
+        " build/limb_gcd.o"
+        " build/limb_x86.o";
 #endif
 
     printf("Creating static library...\n");
@@ -95,11 +113,11 @@ int build_and_run_tests_with_gcc() {
         char cmd[512];
 #ifdef _WIN32
         snprintf(cmd, sizeof(cmd),
-            "gcc tests/%s.c -I./include -L./build/Release -lcalculator -o build\\Release\\tests\\%s.exe",
+            "gcc tests/%s.c -I./include -L./build/Release -lcalculator -lm -o build\\Release\\tests\\%s.exe",
             test_files[i], test_files[i]);
 #else
         snprintf(cmd, sizeof(cmd),
-            "gcc tests/%s.c -I./include -L./build/Release -lcalculator -o build/Release/tests/%s",
+            "gcc tests/%s.c -I./include -L./build/Release -lcalculator -lm -o build/Release/tests/%s",
             test_files[i], test_files[i]);
 #endif
         printf("Compiling test: %s\n", cmd);
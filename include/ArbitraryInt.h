@@ -3,21 +3,31 @@
  * @brief Core arbitrary precision integer implementation
  *
  * Provides the fundamental data structure and operations for
- * handling integers of arbitrary size. Numbers are stored as
- * strings of digits with separate sign handling.
+ * handling integers of arbitrary size. Magnitudes are stored as
+ * little-endian vectors of 64-bit limbs with separate sign handling;
+ * decimal text is only produced when parsing and printing.
  */
 
 #ifndef ARBITRARYINT_H
 #define ARBITRARYINT_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** One machine word of a magnitude */
+typedef uint64_t limb_t;
 
 /**
  * @brief Structure representing an arbitrary precision integer
+ *
+ * Zero is represented with size 0 and is never negative.
  */
 typedef struct {
     bool is_negative;  /**< Sign flag (true if negative) */
-    char *value;      /**< String of digits (null-terminated) */
+    limb_t *limbs;     /**< Magnitude limbs, least significant first */
+    size_t size;       /**< Number of limbs in use (no high zero limbs) */
+    size_t capacity;   /**< Number of limbs allocated */
 } ArbitraryInt;
 
 /**
@@ -27,6 +37,13 @@ typedef struct {
  */
 ArbitraryInt* create_arbitrary_int(const char *str);
 
+/**
+ * @brief Creates a new arbitrary precision integer from a machine word
+ * @param value Non-negative value
+ * @return New ArbitraryInt* or NULL on error
+ */
+ArbitraryInt* create_arbitrary_int_from_uint(uint64_t value);
+
 /**
  * @brief Frees memory used by an arbitrary precision integer
  * @param num Number to free
@@ -41,6 +58,43 @@ void free_arbitrary_int(ArbitraryInt *num);
  */
 int compare_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b);
 
+/**
+ * @brief Compares the absolute values of two arbitrary precision integers
+ * @param a First number
+ * @param b Second number
+ * @return -1 if |a|<|b|, 0 if |a|=|b|, 1 if |a|>|b|
+ */
+int compare_arbitrary_int_magnitudes(const ArbitraryInt *a, const ArbitraryInt *b);
+
+/**
+ * @brief Checks whether a number is zero
+ * @param num Number to check
+ * @return true if num is zero
+ */
+bool is_arbitrary_int_zero(const ArbitraryInt *num);
+
+/**
+ * @brief Converts an arbitrary precision integer to decimal text
+ * @param num Number to convert
+ * @return Newly allocated string (with leading '-' if negative) or NULL on error
+ */
+char* arbitrary_int_to_string(const ArbitraryInt *num);
+
+/**
+ * @brief Writes decimal text into a caller-provided buffer
+ * @param num Number to convert
+ * @param buf Output buffer
+ * @param cap Size of buf in bytes
+ * @return Length of the text without the terminator (0 if num is invalid)
+ *
+ * The text and its terminator are written only if the length is below
+ * cap, so a too-small buffer can be retried with the returned length + 1.
+ * Needs no heap memory with decimal limbs or for values up to
+ * FORMAT_DC_THRESHOLD limbs; larger binary values only allocate scratch
+ * for the divide-and-conquer split, never a copy of the text.
+ */
+size_t to_decimal_string(const ArbitraryInt *num, char *buf, size_t cap);
+
 /**
  * @brief Prints an arbitrary precision integer
  * @param num Number to print
@@ -68,4 +122,26 @@ ArbitraryInt* subtract_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt
  */
 ArbitraryInt* multiply_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b);
 
-#endif // ARBITRARYINT_H 
\ No newline at end of file
+/**
+ * @brief Internal function allocating a zero-valued integer
+ * @param capacity Number of limbs to reserve (at least one is allocated)
+ * @return New ArbitraryInt* or NULL on error
+ */
+ArbitraryInt* allocate_arbitrary_int(size_t capacity);
+
+/**
+ * @brief Internal function growing the limb buffer of an integer
+ * @param num Number to grow
+ * @param capacity Minimum number of limbs required
+ * @return true on success, false if allocation failed
+ */
+bool reserve_arbitrary_int(ArbitraryInt *num, size_t capacity);
+
+/**
+ * @brief Internal function stripping high zero limbs
+ *
+ * Also clears the sign of a zero result.
+ */
+void normalize_arbitrary_int(ArbitraryInt *num);
+
+#endif // ARBITRARYINT_H
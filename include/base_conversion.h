@@ -4,13 +4,26 @@
 
 #include "ArbitraryInt.h"
 
+// Size (in limbs) up to which to_base converts by repeated single-limb
+// division; larger values are split recursively by powers of the base.
+// Override at build time with -DTO_BASE_DC_THRESHOLD=n.
+#ifndef TO_BASE_DC_THRESHOLD
+#define TO_BASE_DC_THRESHOLD 30
+#endif
+
+// Length (in limb-sized digit chunks) up to which from_base folds in one
+// chunk at a time; longer strings are split and combined recursively.
+#ifndef FROM_BASE_DC_THRESHOLD
+#define FROM_BASE_DC_THRESHOLD 30
+#endif
+
 // Converts ArbitraryInt to a string representation in the specified base
 char* to_base(const ArbitraryInt *num, int base);
 
 // Converts a string in the specified base to ArbitraryInt
 ArbitraryInt* from_base(const char *str, int base);
 
-// Helper function to convert a single character to its numerical value
+// Converts a digit character (0-9, A-Z or a-z) to its value 0-35, or -1
 int char_to_value(char c);
 
 #endif // BASE_CONVERSION_H
\ No newline at end of file
@@ -3,8 +3,9 @@
  * @brief Arbitrary precision fraction operations
  *
  * This module provides support for rational number arithmetic using
- * arbitrary precision integers. All fractions are automatically
- * simplified using GCD.
+ * arbitrary precision integers. Fractions made by create_fraction() are
+ * kept in lowest terms; fractions made by create_fraction_lazy() defer the
+ * GCD until their parts have grown enough to pay for it.
  */
 
 #ifndef FRACTION_H
@@ -12,15 +13,27 @@
 
 #include "ArbitraryInt.h"
 
+/**
+ * A lazy fraction is reduced once its numerator and denominator together
+ * exceed twice their size at the last reduction plus this many limbs.
+ */
+#ifndef FRACTION_LAZY_SLACK_LIMBS
+#define FRACTION_LAZY_SLACK_LIMBS 16
+#endif
+
 /**
  * @brief Structure representing a rational number
  * 
  * Stores a fraction as a pair of arbitrary precision integers.
- * Maintains the invariant that denominator is always positive.
+ * Maintains the invariant that denominator is always positive. Eager
+ * fractions are always in lowest terms; lazy ones only when reduced is set.
  */
 typedef struct {
     ArbitraryInt *numerator;    /**< Top number of fraction */
     ArbitraryInt *denominator;  /**< Bottom number of fraction */
+    bool lazy;                  /**< Defer GCD reduction of results */
+    bool reduced;               /**< Known to be in lowest terms */
+    size_t reduced_limbs;       /**< Part sizes at the last reduction */
 } Fraction;
 
 /**
@@ -31,6 +44,35 @@ typedef struct {
  */
 Fraction* create_fraction(const ArbitraryInt *numerator, const ArbitraryInt *denominator);
 
+/**
+ * @brief Creates a new fraction without simplifying it
+ * @param numerator Top number
+ * @param denominator Bottom number (must not be zero)
+ * @return New lazy Fraction* or NULL on error
+ *
+ * Arithmetic involving a lazy fraction returns a lazy fraction, which is
+ * reduced only when it outgrows FRACTION_LAZY_SLACK_LIMBS, is printed, or
+ * is passed to normalize_fraction().
+ */
+Fraction* create_fraction_lazy(const ArbitraryInt *numerator, const ArbitraryInt *denominator);
+
+/**
+ * @brief Reduces a fraction to lowest terms in place
+ * @param frac Fraction to reduce
+ * @return true on success, false on error
+ */
+bool normalize_fraction(Fraction *frac);
+
+/**
+ * @brief Compares two fractions by value
+ * @param a First fraction
+ * @param b Second fraction
+ * @return -1 if a < b, 0 if equal, 1 if a > b
+ *
+ * Cross-multiplies, so unreduced fractions compare correctly as they are.
+ */
+int compare_fractions(const Fraction *a, const Fraction *b);
+
 /**
  * @brief Frees memory used by a fraction
  * @param frac Fraction to free
@@ -63,7 +105,46 @@ Fraction* multiply_fractions(const Fraction *a, const Fraction *b);
 Fraction* divide_fractions(const Fraction *a, const Fraction *b);
 
 /**
- * @brief Print a fraction
+ * @brief Generator for the k-th term of a rational series
+ * @param k Term index
+ * @param p Receives a new ArbitraryInt numerator, owned by the caller
+ * @param q Receives a new nonzero ArbitraryInt denominator, owned by the caller
+ * @param context Caller data passed through unchanged
+ * @return true on success, false to abort the sum
+ */
+typedef bool (*SeriesTermFn)(uint64_t k, ArbitraryInt **p, ArbitraryInt **q, void *context);
+
+/**
+ * @brief Sums p(k)/q(k) for begin <= k < end by binary splitting
+ * @param term Generator for p(k) and q(k)
+ * @param context Passed to term
+ * @param begin First index
+ * @param end One past the last index
+ * @return Sum in lowest terms as new Fraction* or NULL on error
+ *
+ * Halves of the range are summed without reduction and combined as
+ * (N1*D2 + N2*D1)/(D1*D2), so the work ends in a few balanced products
+ * and a single GCD. Suits harmonic-style sums of independent terms.
+ */
+Fraction* sum_series(SeriesTermFn term, void *context, uint64_t begin, uint64_t end);
+
+/**
+ * @brief Sums a series given by the ratio of consecutive terms
+ * @param ratio Generator for p(k) and q(k)
+ * @param context Passed to ratio
+ * @param begin First index
+ * @param end One past the last index
+ * @return Sum in lowest terms as new Fraction* or NULL on error
+ *
+ * Term k is the product of p(j)/q(j) for begin <= j <= k, so exp(1) is
+ * p(k) = 1, q(0) = 1, q(k) = k. Ranges combine as P = P1*P2, Q = Q1*Q2 and
+ * T = T1*Q2 + P1*T2 with the sum equal to T/Q, which keeps the operands
+ * proportional to the size of the ratios instead of the terms.
+ */
+Fraction* sum_ratio_series(SeriesTermFn ratio, void *context, uint64_t begin, uint64_t end);
+
+/**
+ * @brief Print a fraction in lowest terms
  */
 void print_fraction(const Fraction *frac);
 
@@ -0,0 +1,437 @@
+/**
+ * @file limb_ops.h
+ * @brief Low-level kernels on little-endian limb vectors
+ *
+ * Internal building blocks shared by the ArbitraryInt core and the
+ * higher-level operations. Every function works on raw limb arrays of
+ * explicit length; callers own allocation and normalization.
+ */
+
+#ifndef LIMB_OPS_H
+#define LIMB_OPS_H
+
+#include <stddef.h>
+#include "ArbitraryInt.h"
+
+/** Double-width limb used for carries and single-limb products */
+typedef unsigned __int128 dlimb_t;
+
+/** Number of bits in a limb word */
+#define LIMB_BITS 64
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+/** Decimal digits held by one limb */
+#define LIMB_DIGITS 18
+
+/** Radix of the limb representation (10^LIMB_DIGITS) */
+#define LIMB_BASE 1000000000000000000ULL
+
+/** Largest value a limb can hold */
+#define LIMB_MAX (LIMB_BASE - 1)
+
+/** floor(2^123 / LIMB_BASE), reciprocal used by limb_split */
+#define LIMB_BASE_RECIPROCAL 10633823966279326983ULL
+
+/**
+ * @brief Splits a double-width value into high and low limbs
+ * @param x Value below LIMB_BASE * 2^61
+ * @param lo Output for x mod LIMB_BASE
+ * @return x / LIMB_BASE
+ *
+ * Estimates the quotient with a fixed-point reciprocal, which is off by
+ * at most three, then corrects it. Avoids a 128-bit division per limb.
+ */
+static inline limb_t limb_split(dlimb_t x, limb_t *lo) {
+    limb_t q = (limb_t)(((dlimb_t)(limb_t)(x >> 59) * LIMB_BASE_RECIPROCAL) >> 64);
+    limb_t r = (limb_t)(x - (dlimb_t)q * LIMB_BASE);
+    while(r >= LIMB_BASE) {
+        r -= LIMB_BASE;
+        q++;
+    }
+    *lo = r;
+    return q;
+}
+
+/**
+ * @brief Combines two limbs into hi * LIMB_BASE + lo
+ */
+static inline dlimb_t limb_join(limb_t hi, limb_t lo) {
+    return (dlimb_t)hi * LIMB_BASE + lo;
+}
+#else
+/** Largest value a limb can hold */
+#define LIMB_MAX UINT64_MAX
+
+/**
+ * @brief Splits a double-width value into high and low limbs
+ * @param x Value to split
+ * @param lo Output for the low limb
+ * @return High limb
+ */
+static inline limb_t limb_split(dlimb_t x, limb_t *lo) {
+    *lo = (limb_t)x;
+    return (limb_t)(x >> LIMB_BITS);
+}
+
+/**
+ * @brief Combines two limbs into hi * 2^64 + lo
+ */
+static inline dlimb_t limb_join(limb_t hi, limb_t lo) {
+    return ((dlimb_t)hi << LIMB_BITS) | lo;
+}
+#endif
+
+/**
+ * @brief Adds two limb vectors of equal length
+ * @param r Result (n limbs, may alias a or b)
+ * @param a First operand
+ * @param b Second operand
+ * @param n Number of limbs
+ * @return Carry out of the top limb (0 or 1)
+ */
+limb_t limbs_add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Adds a single limb to a limb vector
+ * @param r Result (n limbs, may alias a)
+ * @param a Operand
+ * @param n Number of limbs in a
+ * @param b Limb to add
+ * @return Carry out of the top limb
+ */
+limb_t limbs_add_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Adds two limb vectors where an >= bn
+ * @return Carry out of limb an-1
+ */
+limb_t limbs_add(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Subtracts two limb vectors of equal length (r = a - b)
+ * @return Borrow out of the top limb (0 or 1)
+ */
+limb_t limbs_sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Subtracts a single limb from a limb vector
+ * @return Borrow out of the top limb
+ */
+limb_t limbs_sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Subtracts two limb vectors where an >= bn (r = a - b)
+ * @return Borrow out of limb an-1
+ */
+limb_t limbs_sub(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Multiplies a limb vector by a single limb (r = a * b)
+ * @return High limb of the product
+ */
+limb_t limbs_mul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Multiplies and accumulates (r += a * b)
+ * @return Carry limb out of r[n-1]
+ */
+limb_t limbs_addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Multiplies and subtracts (r -= a * b)
+ * @return Borrow limb out of r[n-1]
+ */
+limb_t limbs_submul_1(limb_t *r, const limb_t *a, size_t n, limb_t b);
+
+/**
+ * @brief Divides a limb vector by a single non-zero limb
+ * @param q Quotient (n limbs, may alias a)
+ * @param a Dividend
+ * @param n Number of limbs in a
+ * @param d Divisor
+ * @return Remainder
+ */
+limb_t limbs_divrem_1(limb_t *q, const limb_t *a, size_t n, limb_t d);
+
+/**
+ * @brief Divides a limb vector by a single limb that divides it exactly
+ * @param q Quotient (n limbs, may alias a)
+ * @param a Dividend, a multiple of d
+ * @param n Number of limbs in a
+ * @param d Non-zero divisor
+ *
+ * Binary limbs use a multiplicative inverse instead of hardware
+ * division; the result is undefined if d does not divide a.
+ */
+void limbs_divexact_1(limb_t *q, const limb_t *a, size_t n, limb_t d);
+
+/**
+ * @brief Compares two limb vectors of equal length
+ * @return -1 if a<b, 0 if a=b, 1 if a>b
+ */
+int limbs_cmp(const limb_t *a, const limb_t *b, size_t n);
+
+/**
+ * @brief Returns n with high zero limbs stripped
+ */
+size_t limbs_normalized_size(const limb_t *a, size_t n);
+
+/**
+ * @brief Allocates scratch limbs, exiting on allocation failure
+ * @param n Number of limbs
+ * @return Uninitialized limb buffer to be released with free()
+ */
+limb_t* limbs_alloc(size_t n);
+
+/**
+ * Operand size (in limbs) from which limbs_mul switches from schoolbook
+ * to Karatsuba. Override at build time with -DKARATSUBA_THRESHOLD=n.
+ */
+#ifndef KARATSUBA_THRESHOLD
+#define KARATSUBA_THRESHOLD 32
+#endif
+
+/** Operand size (in limbs) from which limbs_mul uses Toom-3 */
+#ifndef TOOM3_THRESHOLD
+#define TOOM3_THRESHOLD 120
+#endif
+
+/** Operand size (in limbs) from which limbs_mul uses Toom-4 */
+#ifndef TOOM4_THRESHOLD
+#define TOOM4_THRESHOLD 400
+#endif
+
+/**
+ * Operand size (in limbs) from which limbs_sqr switches from schoolbook
+ * squaring to Karatsuba. Override at build time with
+ * -DSQR_KARATSUBA_THRESHOLD=n.
+ */
+#ifndef SQR_KARATSUBA_THRESHOLD
+#define SQR_KARATSUBA_THRESHOLD 48
+#endif
+
+/** Operand size (in limbs) from which limbs_sqr uses Toom-3 */
+#ifndef SQR_TOOM3_THRESHOLD
+#define SQR_TOOM3_THRESHOLD 140
+#endif
+
+/** Operand size (in limbs) from which limbs_sqr uses Toom-4 */
+#ifndef SQR_TOOM4_THRESHOLD
+#define SQR_TOOM4_THRESHOLD 400
+#endif
+
+/**
+ * Operand size (in limbs) from which limbs_mul switches to the
+ * three-prime NTT. Override at build time with -DNTT_THRESHOLD=n.
+ */
+#ifndef NTT_THRESHOLD
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+#define NTT_THRESHOLD 3000
+#else
+#define NTT_THRESHOLD 16000
+#endif
+#endif
+
+/** Largest an + bn the NTT can multiply (2^23 transform points) */
+#define NTT_MAX_LIMBS ((size_t)1 << 22)
+
+/**
+ * @brief Schoolbook product of a (an limbs) and b (bn limbs)
+ * @param r Result with an+bn limbs, must not overlap a or b
+ *
+ * Requires an >= bn >= 1.
+ */
+void limbs_mul_basecase(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Schoolbook square of a (n >= 1 limbs)
+ * @param r Result with 2n limbs, must not overlap a
+ *
+ * Computes each cross product a[i]*a[j] once and doubles the sum,
+ * roughly halving the limb multiplications of limbs_mul_basecase.
+ */
+void limbs_sqr_basecase(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Squares a limb vector using the best available algorithm
+ * @param r Result with 2n limbs, must not overlap a
+ *
+ * Requires n >= 1. Mirrors limbs_mul's tiers with squaring variants
+ * and their own SQR_* thresholds; the NTT is shared.
+ */
+void limbs_sqr(limb_t *r, const limb_t *a, size_t n);
+
+/**
+ * @brief Product by three-prime number-theoretic transform
+ * @param r Result with an+bn limbs, must not overlap a or b
+ *
+ * Requires an >= bn >= 1 and an + bn <= NTT_MAX_LIMBS. Squares with
+ * two transforms instead of three per prime when a == b.
+ */
+void limbs_mul_ntt(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Multiplies two limb vectors using the best available algorithm
+ * @param r Result with an+bn limbs, must not overlap a or b
+ *
+ * Requires an >= bn >= 1. Uses schoolbook below KARATSUBA_THRESHOLD,
+ * then Karatsuba, Toom-3, Toom-4 and the NTT as the shorter operand
+ * crosses each tier's threshold, with one scratch allocation for the
+ * whole call. Hands a == b with an == bn to limbs_sqr.
+ */
+void limbs_mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * Divisor size (in limbs) from which limbs_divrem switches from
+ * schoolbook to Burnikel-Ziegler division. Override at build time with
+ * -DDIV_BZ_THRESHOLD=n (at least 4).
+ */
+#ifndef DIV_BZ_THRESHOLD
+#define DIV_BZ_THRESHOLD 40
+#endif
+
+/** Divisor size (in limbs) from which division uses a Newton reciprocal */
+#ifndef DIV_NEWTON_THRESHOLD
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+#define DIV_NEWTON_THRESHOLD 8000
+#else
+#define DIV_NEWTON_THRESHOLD 1500
+#endif
+#endif
+
+/**
+ * @brief Divides limb vectors with the best available algorithm
+ * @param q Quotient with an-dn+1 limbs
+ * @param r Remainder with dn limbs
+ * @param a Dividend (an limbs)
+ * @param d Divisor (dn limbs, top limb non-zero)
+ *
+ * Requires an >= dn >= 1. q and r must not overlap a, d or each other.
+ * Uses schoolbook long division (Knuth algorithm D) below
+ * DIV_BZ_THRESHOLD, Burnikel-Ziegler recursion above it and Newton
+ * reciprocals for blocks from DIV_NEWTON_THRESHOLD limbs on.
+ */
+void limbs_divrem(limb_t *q, limb_t *r, const limb_t *a, size_t an, const limb_t *d, size_t dn);
+
+/**
+ * Operand size (in limbs) from which limbs_gcd switches from Lehmer's
+ * algorithm to the recursive half-GCD. Override at build time with
+ * -DGCD_HGCD_THRESHOLD=n (at least 4).
+ */
+#ifndef GCD_HGCD_THRESHOLD
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+#define GCD_HGCD_THRESHOLD 400
+#else
+#define GCD_HGCD_THRESHOLD 800
+#endif
+#endif
+
+/**
+ * @brief Greatest common divisor of two limb vectors
+ * @param g Result, room for min(an, bn) limbs
+ * @param a First operand (an limbs, top limb non-zero)
+ * @param b Second operand (bn limbs, top limb non-zero)
+ * @return Number of limbs in g
+ *
+ * Requires an, bn >= 1; g may not overlap a or b. Uses Lehmer's
+ * algorithm with one-limb cofactors, a recursive half-GCD from
+ * GCD_HGCD_THRESHOLD limbs on, and finishes two-limb operands with
+ * binary GCD.
+ */
+size_t limbs_gcd(limb_t *g, const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * @brief Greatest common divisor with the cofactor of a
+ * @param g Result, room for min(an, bn) limbs
+ * @param s Magnitude of the cofactor, room for max(an, bn) + 1 limbs
+ * @param sn Output for the number of limbs in s (0 if s is zero)
+ * @param s_negative Output for the sign of s
+ * @return Number of limbs in g
+ *
+ * Finds s with a*s = g (mod b), |s| <= b/g, under the same requirements
+ * as limbs_gcd. The cofactor of b is (g - a*s) / b.
+ */
+size_t limbs_gcdext(limb_t *g, limb_t *s, size_t *sn, bool *s_negative,
+                    const limb_t *a, size_t an, const limb_t *b, size_t bn);
+
+/**
+ * Kernel tiers, from portable C up. Each x86-64 tier requires the
+ * instructions of the tiers below it.
+ */
+typedef enum {
+    LIMB_TIER_GENERIC,   // Portable C
+    LIMB_TIER_X86_64,    // Baseline x86-64 (ADC/SBB loops)
+    LIMB_TIER_AVX2,      // AVX2 carry-lookahead add/subtract
+    LIMB_TIER_ADX,       // BMI2 and ADX (MULX, ADCX, ADOX)
+    LIMB_TIER_AVX512,    // AVX-512F eight-lane add/subtract
+    LIMB_TIER_COUNT
+} LimbTier;
+
+/**
+ * Environment variable that forces a kernel tier by name ("generic",
+ * "x86-64", "avx2", "adx" or "avx512"), for benchmarking and debugging.
+ * Tiers the CPU does not support are refused with a warning.
+ */
+#define LIMB_TIER_ENV "ARBITRARY_INT_TIER"
+
+/**
+ * @brief Implementations of the primitives for one tier
+ *
+ * limbs_add_n, limbs_sub_n, limbs_mul_1, limbs_addmul_1, limbs_submul_1
+ * and limbs_divrem_1 call through the table chosen for the running CPU.
+ */
+typedef struct {
+    LimbTier tier;
+    const char *name;
+    limb_t (*add_n)(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+    limb_t (*sub_n)(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+    limb_t (*mul_1)(limb_t *r, const limb_t *a, size_t n, limb_t b);
+    limb_t (*addmul_1)(limb_t *r, const limb_t *a, size_t n, limb_t b);
+    limb_t (*submul_1)(limb_t *r, const limb_t *a, size_t n, limb_t b);
+    limb_t (*divrem_1)(limb_t *q, const limb_t *a, size_t n, limb_t d);
+} LimbKernels;
+
+/**
+ * @brief Returns the kernel table in use
+ *
+ * Chosen once, when the library is loaded or on first use, from cpuid
+ * and LIMB_TIER_ENV. Safe to call from several threads.
+ */
+const LimbKernels* limbs_kernels(void);
+
+/**
+ * @brief Best tier the running CPU and operating system support
+ */
+LimbTier limbs_cpu_tier(void);
+
+#if defined(__x86_64__) && defined(__GNUC__)
+/** Defined when the x86-64 kernels in limb_x86.c are built */
+#define LIMB_X86_KERNELS 1
+
+/*
+ * x86-64 kernels with the contracts of the generic functions. Each may
+ * only run on CPUs that support its tier.
+ */
+
+/** limbs_add_n/limbs_sub_n with four-lane AVX2 carry lookahead */
+limb_t limbs_add_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t limbs_sub_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+/** limbs_add_n/limbs_sub_n with eight-lane AVX-512 carry lookahead */
+limb_t limbs_add_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t limbs_sub_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+/**
+ * Binary-limb kernels in inline assembly: MULX with ADCX/ADOX carry
+ * chains for the multiplications, unrolled ADC/SBB loops (baseline
+ * x86-64) for addition and subtraction.
+ */
+limb_t limbs_mul_1_adx(limb_t *r, const limb_t *a, size_t n, limb_t b);
+limb_t limbs_addmul_1_adx(limb_t *r, const limb_t *a, size_t n, limb_t b);
+limb_t limbs_add_n_adc(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+limb_t limbs_sub_n_adc(limb_t *r, const limb_t *a, const limb_t *b, size_t n);
+#endif
+#endif
+
+#endif // LIMB_OPS_H
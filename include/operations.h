@@ -35,11 +35,21 @@ ArbitraryInt* subtract(const ArbitraryInt *a, const ArbitraryInt *b);
  */
 ArbitraryInt* multiply(const ArbitraryInt *a, const ArbitraryInt *b);
 
+/**
+ * @brief Squares an arbitrary precision integer
+ * @param a Operand
+ * @return Square a*a as new ArbitraryInt* or NULL on error
+ *
+ * Faster than a general product of two numbers of the same size;
+ * multiply() uses it automatically when |a| == |b|.
+ */
+ArbitraryInt* square(const ArbitraryInt *a);
+
 /**
  * @brief Divides two arbitrary precision integers
  * @param a Dividend
  * @param b Divisor
- * @param remainder Optional pointer to store remainder
+ * @param remainder Optional pointer to store the remainder |a| mod |b|
  * @return Quotient as new ArbitraryInt* or NULL on error
  */
 ArbitraryInt* divide(const ArbitraryInt *a, const ArbitraryInt *b, ArbitraryInt **remainder);
@@ -75,6 +85,27 @@ ArbitraryInt* factorial(const ArbitraryInt *n);
  */
 ArbitraryInt* logarithm(const ArbitraryInt *num, const ArbitraryInt *base);
 
+/**
+ * @brief Computes the greatest common divisor
+ * @param a First operand
+ * @param b Second operand
+ * @return gcd(|a|, |b|) as new ArbitraryInt* (gcd(0, 0) = 0) or NULL on error
+ */
+ArbitraryInt* gcd(const ArbitraryInt *a, const ArbitraryInt *b);
+
+/**
+ * @brief Computes the greatest common divisor and Bezout cofactors
+ * @param a First operand
+ * @param b Second operand
+ * @param s Optional pointer to store the cofactor of a
+ * @param t Optional pointer to store the cofactor of b
+ * @return g = gcd(|a|, |b|) as new ArbitraryInt* or NULL on error
+ *
+ * The cofactors satisfy a*s + b*t = g with |s| <= |b|/g and
+ * |t| <= |a|/g when both operands are non-zero.
+ */
+ArbitraryInt* gcdext(const ArbitraryInt *a, const ArbitraryInt *b, ArbitraryInt **s, ArbitraryInt **t);
+
 /**
  * @brief Creates a deep copy of an arbitrary precision integer
  * @param num Number to copy
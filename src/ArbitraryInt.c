@@ -2,16 +2,33 @@
  * @file ArbitraryInt.c
  * @brief Implementation of arbitrary precision integer operations
  *
- * Core implementation of arbitrary precision integers using string-based
- * storage. Includes basic arithmetic and utility functions.
+ * Core implementation of arbitrary precision integers using 64-bit limb
+ * storage. Includes basic arithmetic, decimal parsing/printing and
+ * utility functions. With ARBITRARY_INT_DECIMAL_LIMBS each limb holds
+ * 18 decimal digits instead, which turns parsing and printing into
+ * linear-time chunk copies.
  */
 
 #include "ArbitraryInt.h"
+#include "limb_ops.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 #include <limits.h>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+/** Decimal digits per chunk; one chunk is exactly one limb */
+#define DECIMAL_CHUNK_DIGITS LIMB_DIGITS
+#else
+/** Decimal digits converted per limb operation when parsing/printing */
+#define DECIMAL_CHUNK_DIGITS 19
+
+/** 10^DECIMAL_CHUNK_DIGITS, the largest power of ten that fits in a limb */
+#define DECIMAL_CHUNK_BASE 10000000000000000000ULL
+#endif
 
 // Add cross-platform string duplication
 static char* duplicate_string(const char *str) {
@@ -22,136 +39,622 @@ static char* duplicate_string(const char *str) {
 #endif
 }
 
+ArbitraryInt* allocate_arbitrary_int(size_t capacity) {
+    if(capacity == 0) {
+        capacity = 1;
+    }
+
+    ArbitraryInt *num = malloc(sizeof(ArbitraryInt));
+    if(!num) {
+        return NULL;
+    }
+
+    num->limbs = malloc(capacity * sizeof(limb_t));
+    if(!num->limbs) {
+        free(num);
+        return NULL;
+    }
+
+    num->is_negative = false;
+    num->size = 0;
+    num->capacity = capacity;
+    return num;
+}
+
+bool reserve_arbitrary_int(ArbitraryInt *num, size_t capacity) {
+    if(capacity <= num->capacity) {
+        return true;
+    }
+
+    limb_t *limbs = realloc(num->limbs, capacity * sizeof(limb_t));
+    if(!limbs) {
+        return false;
+    }
+    num->limbs = limbs;
+    num->capacity = capacity;
+    return true;
+}
+
+void normalize_arbitrary_int(ArbitraryInt *num) {
+    num->size = limbs_normalized_size(num->limbs, num->size);
+    if(num->size == 0) {
+        num->is_negative = false;
+    }
+}
+
 /**
- * @brief Removes leading zeros from a number string
- * @param str Input string
- * @return New string without leading zeros
+ * @brief Finds the first byte that is not an ASCII digit
+ * @param str Characters to check
+ * @param len Number of characters
+ * @return Index of the first non-digit, or len if all are digits
+ *
+ * Checks 32 bytes per step with AVX2 or 16 with SSE2; bytes >= 0x80
+ * compare as negative and fail the signed range check.
  */
-static char* remove_leading_zeros(const char *str) {
-    while(*str == '0' && *(str+1) != '\0') {
-        str++;
+static size_t find_non_digit(const char *str, size_t len) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i low32 = _mm256_set1_epi8('0' - 1);
+    const __m256i high32 = _mm256_set1_epi8('9' + 1);
+    for(; i + 32 <= len; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(str + i));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(block, low32),
+                                         _mm256_cmpgt_epi8(high32, block));
+        if((unsigned)_mm256_movemask_epi8(digit) != 0xFFFFFFFFu) {
+            break;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i low = _mm_set1_epi8('0' - 1);
+    const __m128i high = _mm_set1_epi8('9' + 1);
+    for(; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(str + i));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(block, low), _mm_cmplt_epi8(block, high));
+        if(_mm_movemask_epi8(digit) != 0xFFFF) {
+            break;
+        }
+    }
+#endif
+    while(i < len && str[i] >= '0' && str[i] <= '9') {
+        i++;
     }
-    return duplicate_string(str);
+    return i;
 }
 
 /**
- * @brief Reverses a string in place
- * @param str String to reverse
+ * @brief Counts leading '0' characters, keeping at least one digit
  */
-static void reverse_str(char *str) {
-    int i, j;
-    char temp;
-    size_t len = strlen(str);
-    for(i = 0, j = len -1; i < j; i++, j--) {
-        temp = str[i];
-        str[i] = str[j];
-        str[j] = temp;
+static size_t count_leading_zeros(const char *str, size_t len) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    while(i + 16 < len &&
+          _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(str + i)), zero)) == 0xFFFF) {
+        i += 16;
+    }
+#endif
+    while(i + 1 < len && str[i] == '0') {
+        i++;
     }
+    return i;
 }
 
+#if defined(__SSE2__)
 /**
- * @brief Adds absolute values of two numbers
- * @param a First number
- * @param b Second number
- * @return Sum as string
+ * @brief Converts 16 validated digits to their value
+ *
+ * Widens the digits to 16 bits and merges neighbours with multiply-adds
+ * by 10, 100 and 10^4, leaving two 8-digit halves.
  */
-static char* add_absolute(const char *a, const char *b) {
-    size_t len_a = strlen(a);
-    size_t len_b = strlen(b);
-    size_t max_len = (len_a > len_b) ? len_a : len_b;
-    char *result = calloc(max_len + 2, sizeof(char));
-    if(!result) {
-        return NULL;
-    }
+static uint64_t parse_16_digits(const char *str) {
+    __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)str), _mm_set1_epi8('0'));
+    __m128i zero = _mm_setzero_si128();
+    __m128i tens = _mm_set_epi16(1, 10, 1, 10, 1, 10, 1, 10);
+    __m128i pairs = _mm_packs_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(digits, zero), tens),
+                                    _mm_madd_epi16(_mm_unpackhi_epi8(digits, zero), tens));
+    __m128i quads = _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+    quads = _mm_packs_epi32(quads, quads);
+    __m128i eights = _mm_madd_epi16(quads, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+    uint64_t high = (uint32_t)_mm_cvtsi128_si32(eights);
+    uint64_t low = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(eights, 4));
+    return high * 100000000ULL + low;
+}
+#endif
 
-    int carry = 0, sum;
-    int digit_a, digit_b;
-    for(int i = 0; i < max_len; i++) {
-        digit_a = (i < len_a) ? (a[len_a -1 -i] - '0') : 0;
-        digit_b = (i < len_b) ? (b[len_b -1 -i] - '0') : 0;
-        sum = digit_a + digit_b + carry;
-        carry = sum / 10;
-        result[i] = (sum % 10) + '0';
+/**
+ * @brief Parses exactly len decimal digits into a machine word
+ * @param str Digit characters (already validated)
+ * @param len Number of digits, at most DECIMAL_CHUNK_DIGITS
+ * @return Value of the digits
+ */
+static limb_t parse_chunk(const char *str, size_t len) {
+    limb_t value = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    if(len >= 16) {
+        value = parse_16_digits(str);
+        i = 16;
     }
-    if(carry) {
-        result[max_len] = carry + '0';
+#endif
+    for(; i < len; i++) {
+        value = value * 10 + (limb_t)(str[i] - '0');
     }
-    reverse_str(result);
-    return result;
+    return value;
 }
 
-// Factory function to create ArbitraryInt from string
-ArbitraryInt* create_arbitrary_int(const char *str) {
-    if(str == NULL) return NULL;
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+/**
+ * Chunk count from which parsing combines the 19-digit chunks pairwise
+ * with fast multiplication instead of folding them in one at a time.
+ */
+#ifndef PARSE_DC_THRESHOLD
+#define PARSE_DC_THRESHOLD 64
+#endif
 
-    ArbitraryInt *num = malloc(sizeof(ArbitraryInt));
-    if(!num) {
-        return NULL;
+/**
+ * @brief Combines decimal chunks into binary limbs in a balanced tree
+ * @param chunks Chunk values below 10^19, least significant first; freed
+ * @param count Number of chunks
+ * @param num Output with capacity for count limbs
+ *
+ * Level k holds blocks of 2^k chunks in slots of 2^k limbs. Neighbouring
+ * slots merge as high * 10^(19*2^k) + low, and the power is squared for
+ * the next level, so the cost is O(M(n) log n) instead of quadratic.
+ */
+static void combine_chunks(limb_t *chunks, size_t count, ArbitraryInt *num) {
+    size_t width = 1;
+    limb_t *power = limbs_alloc(1);
+    size_t power_size = 1;
+    power[0] = DECIMAL_CHUNK_BASE;
+
+    while(count > 1) {
+        size_t next_count = (count + 1) / 2;
+        limb_t *next = limbs_alloc(next_count * 2 * width);
+        for(size_t j = 0; j < next_count; j++) {
+            const limb_t *low = chunks + 2 * j * width;
+            limb_t *dst = next + 2 * j * width;
+            size_t high_size = 2 * j + 1 < count ? limbs_normalized_size(low + width, width) : 0;
+
+            memset(dst + width, 0, width * sizeof(limb_t));
+            if(high_size == 0) {
+                memcpy(dst, low, width * sizeof(limb_t));
+                continue;
+            }
+            if(high_size >= power_size) {
+                limbs_mul(dst, low + width, high_size, power, power_size);
+            } else {
+                limbs_mul(dst, power, power_size, low + width, high_size);
+            }
+            memset(dst + high_size + power_size, 0,
+                   (2 * width - high_size - power_size) * sizeof(limb_t));
+            limbs_add(dst, dst, 2 * width, low, width);
+        }
+        free(chunks);
+        chunks = next;
+        count = next_count;
+        width *= 2;
+
+        if(count > 1) {
+            limb_t *square = limbs_alloc(2 * power_size);
+            limbs_sqr(square, power, power_size);
+            free(power);
+            power = square;
+            power_size = limbs_normalized_size(power, 2 * power_size);
+        }
     }
 
-    // Initialize
-    num->is_negative = false;
-    num->value = NULL;
+    size_t size = limbs_normalized_size(chunks, width);
+    memcpy(num->limbs, chunks, size * sizeof(limb_t));
+    num->size = size;
+    free(chunks);
+    free(power);
+}
+#endif
+
+// Factory function to create ArbitraryInt from string
+ArbitraryInt* create_arbitrary_int(const char *str) {
+    if(str == NULL) return NULL;
 
     // Handle sign
+    bool is_negative = false;
     if(str[0] == '-') {
-        num->is_negative = true;
+        is_negative = true;
         str++;
     }
 
     // Validate digits
     size_t len = strlen(str);
-    if (len == 0 || len > INT_MAX) {
-        free(num);
+    if (len == 0 || len > INT_MAX || find_non_digit(str, len) < len) {
         return NULL;
     }
 
-    for(size_t i = 0; i < len; i++) {
-        if(!isdigit(str[i])) {
-            free(num);
-            return NULL;
+    // Skip leading zeros in place
+    size_t zeros = count_leading_zeros(str, len);
+    str += zeros;
+    len -= zeros;
+
+    ArbitraryInt *num = allocate_arbitrary_int(len / DECIMAL_CHUNK_DIGITS + 1);
+    if(!num) {
+        return NULL;
+    }
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    // Each limb is one 18-digit chunk, taken from the least significant end
+    size_t end = len;
+    while(end > 0) {
+        size_t chunk_len = end < DECIMAL_CHUNK_DIGITS ? end : DECIMAL_CHUNK_DIGITS;
+        num->limbs[num->size++] = parse_chunk(str + end - chunk_len, chunk_len);
+        end -= chunk_len;
+    }
+    normalize_arbitrary_int(num);
+#else
+    size_t count = (len + DECIMAL_CHUNK_DIGITS - 1) / DECIMAL_CHUNK_DIGITS;
+    if(count >= PARSE_DC_THRESHOLD) {
+        // Chunks from the least significant end, then a pairwise combine
+        limb_t *chunks = limbs_alloc(count);
+        size_t end = len;
+        for(size_t i = 0; i < count; i++) {
+            size_t chunk_len = end < DECIMAL_CHUNK_DIGITS ? end : DECIMAL_CHUNK_DIGITS;
+            chunks[i] = parse_chunk(str + end - chunk_len, chunk_len);
+            end -= chunk_len;
         }
+        combine_chunks(chunks, count, num);
+        num->is_negative = is_negative && num->size > 0;
+        return num;
     }
 
-    // Remove leading zeros
-    num->value = remove_leading_zeros(str);
-    if (!num->value) {
-        free(num);
-        return NULL;
+    // Fold in one chunk at a time, most significant first: num = num * 10^19 + chunk
+    size_t chunk_len = len % DECIMAL_CHUNK_DIGITS;
+    if(chunk_len == 0) {
+        chunk_len = DECIMAL_CHUNK_DIGITS;
+    }
+    for(size_t pos = 0; pos < len; pos += chunk_len, chunk_len = DECIMAL_CHUNK_DIGITS) {
+        limb_t carry = limbs_mul_1(num->limbs, num->limbs, num->size, DECIMAL_CHUNK_BASE);
+        if(carry) {
+            num->limbs[num->size++] = carry;
+        }
+        carry = limbs_add_1(num->limbs, num->limbs, num->size, parse_chunk(str + pos, chunk_len));
+        if(carry) {
+            num->limbs[num->size++] = carry;
+        }
     }
+#endif
 
+    num->is_negative = is_negative && num->size > 0;
+    return num;
+}
+
+ArbitraryInt* create_arbitrary_int_from_uint(uint64_t value) {
+    ArbitraryInt *num = allocate_arbitrary_int(2);
+    if(!num) {
+        return NULL;
+    }
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    num->limbs[0] = value % LIMB_BASE;
+    num->limbs[1] = value / LIMB_BASE;
+    num->size = 2;
+#else
+    num->limbs[0] = value;
+    num->size = 1;
+#endif
+    normalize_arbitrary_int(num);
     return num;
 }
 
 void free_arbitrary_int(ArbitraryInt *num) {
     if(num) {
-        free(num->value);
+        free(num->limbs);
         free(num);
     }
 }
 
+bool is_arbitrary_int_zero(const ArbitraryInt *num) {
+    return num->size == 0;
+}
+
+// Compare absolute values of two ArbitraryInts
+int compare_arbitrary_int_magnitudes(const ArbitraryInt *a, const ArbitraryInt *b) {
+    if(a->size != b->size) {
+        return a->size > b->size ? 1 : -1;
+    }
+    return limbs_cmp(a->limbs, b->limbs, a->size);
+}
+
 // Compare two ArbitraryInts
 int compare_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
-    if(a->is_negative != b->is_negative) {
-        return a->is_negative ? -1 : 1;
+    bool a_negative = a->is_negative && a->size > 0;
+    bool b_negative = b->is_negative && b->size > 0;
+    if(a_negative != b_negative) {
+        return a_negative ? -1 : 1;
     }
 
     // Both are positive or both are negative
-    int sign_multiplier = a->is_negative ? -1 : 1;
+    int sign_multiplier = a_negative ? -1 : 1;
+    return compare_arbitrary_int_magnitudes(a, b) * sign_multiplier;
+}
+
+/**
+ * @brief Writes a chunk as exactly digits characters, zero padded
+ * @param dst Output buffer
+ * @param value Chunk value
+ * @param digits Number of characters to write
+ */
+static void write_chunk(char *dst, limb_t value, size_t digits) {
+    for(size_t i = digits; i-- > 0;) {
+        dst[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Writes a value below 10^16 as exactly 16 ASCII digits
+ *
+ * Splits the value into four 4-digit groups, broadcasts each group to four
+ * 16-bit lanes and extracts v/1000, v/100, v/10 and v with multiply-high
+ * by reciprocals (a second multiply-high applies the per-lane shift).
+ * Subtracting ten times the lane below leaves one digit per lane.
+ */
+static void write_16_digits(char *dst, uint64_t value) {
+    uint32_t high = (uint32_t)(value / 100000000);
+    uint32_t low = (uint32_t)(value % 100000000);
+    short g0 = (short)(high / 10000), g1 = (short)(high % 10000);
+    short g2 = (short)(low / 10000), g3 = (short)(low % 10000);
+
+    const __m128i reciprocals = _mm_set_epi16((short)32768, 13108, 5243, 8389,
+                                              (short)32768, 13108, 5243, 8389);
+    const __m128i shifts = _mm_set_epi16((short)(1 << 15), 1 << 13, 1 << 11, 1 << 7,
+                                         (short)(1 << 15), 1 << 13, 1 << 11, 1 << 7);
+    const __m128i ten = _mm_set1_epi16(10);
+
+    __m128i first = _mm_slli_epi16(_mm_set_epi16(g1, g1, g1, g1, g0, g0, g0, g0), 2);
+    __m128i second = _mm_slli_epi16(_mm_set_epi16(g3, g3, g3, g3, g2, g2, g2, g2), 2);
+    first = _mm_mulhi_epu16(_mm_mulhi_epu16(first, reciprocals), shifts);
+    second = _mm_mulhi_epu16(_mm_mulhi_epu16(second, reciprocals), shifts);
+    first = _mm_sub_epi16(first, _mm_mullo_epi16(_mm_slli_epi64(first, 16), ten));
+    second = _mm_sub_epi16(second, _mm_mullo_epi16(_mm_slli_epi64(second, 16), ten));
+
+    __m128i ascii = _mm_add_epi8(_mm_packus_epi16(first, second), _mm_set1_epi8('0'));
+    _mm_storeu_si128((__m128i *)dst, ascii);
+}
+#endif
+
+/**
+ * @brief Writes a chunk as exactly DECIMAL_CHUNK_DIGITS characters
+ */
+static void write_full_chunk(char *dst, limb_t value) {
+#if defined(__SSE2__)
+    write_chunk(dst, value / 10000000000000000ULL, DECIMAL_CHUNK_DIGITS - 16);
+    write_16_digits(dst + DECIMAL_CHUNK_DIGITS - 16, value % 10000000000000000ULL);
+#else
+    write_chunk(dst, value, DECIMAL_CHUNK_DIGITS);
+#endif
+}
 
-    size_t len_a = strlen(a->value);
-    size_t len_b = strlen(b->value);
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+/**
+ * Size (in limbs) up to which formatting peels 19-digit chunks off by
+ * single-limb division; larger values are split by powers of 10^19.
+ */
+#ifndef FORMAT_DC_THRESHOLD
+#define FORMAT_DC_THRESHOLD 30
+#endif
 
-    if(len_a > len_b) {
-        return 1 * sign_multiplier;
+/** Most chunks a value of n limbs can have: 64 bits hold 19.27 digits */
+#define MAX_CHUNKS(n) ((n) + (n) / 32 + 1)
+
+/**
+ * @brief Peels exactly count chunks off a value, least significant first
+ * @param work Value (n limbs), destroyed
+ * @param chunks Output for count chunks; zero chunks pad the top
+ */
+static void peel_chunks(limb_t *work, size_t n, limb_t *chunks, size_t count) {
+    size_t i = 0;
+    for(; i < count && n > 0; i++) {
+        chunks[i] = limbs_divrem_1(work, work, n, DECIMAL_CHUNK_BASE);
+        n = limbs_normalized_size(work, n);
     }
-    if(len_a < len_b) {
-        return -1 * sign_multiplier;
+    memset(chunks + i, 0, (count - i) * sizeof(limb_t));
+}
+
+/**
+ * @brief Writes the 2^level chunks of x < powers[level]
+ * @param powers powers[k] = 10^(19*2^k) with sizes in power_sizes
+ *
+ * Divides by powers[level-1] and recurses into the remainder (low chunks)
+ * and quotient (high chunks), peeling once the value is small.
+ */
+static void split_chunks(const limb_t *x, size_t n, limb_t **powers, const size_t *power_sizes,
+                         size_t level, limb_t *chunks) {
+    size_t count = (size_t)1 << level;
+    if(level == 0 || n <= FORMAT_DC_THRESHOLD) {
+        limb_t *work = limbs_alloc(n ? n : 1);
+        memcpy(work, x, n * sizeof(limb_t));
+        peel_chunks(work, n, chunks, count);
+        free(work);
+        return;
     }
 
-    // If lengths are equal, perform lexicographical comparison
-    int cmp = strcmp(a->value, b->value);
-    return cmp * sign_multiplier;
+    const limb_t *d = powers[level - 1];
+    size_t dn = power_sizes[level - 1];
+    if(n < dn) {
+        split_chunks(x, n, powers, power_sizes, level - 1, chunks);
+        memset(chunks + count / 2, 0, count / 2 * sizeof(limb_t));
+        return;
+    }
+
+    limb_t *q = limbs_alloc(n - dn + 1);
+    limb_t *r = limbs_alloc(dn);
+    limbs_divrem(q, r, x, n, d, dn);
+    split_chunks(r, limbs_normalized_size(r, dn), powers, power_sizes, level - 1, chunks);
+    split_chunks(q, limbs_normalized_size(q, n - dn + 1), powers, power_sizes, level - 1,
+                 chunks + count / 2);
+    free(q);
+    free(r);
+}
+
+/**
+ * @brief Splits a large magnitude into 19-digit chunks
+ * @param count Receives the number of chunks without high zero chunks
+ * @return Heap array of chunks, least significant first
+ *
+ * Squares 10^19 until powers[top]^2 exceeds the value, then splits top
+ * down, so the work is O(M(n) log n) instead of quadratic.
+ */
+static limb_t* split_into_chunks(const ArbitraryInt *num, size_t *count) {
+    limb_t *powers[LIMB_BITS];
+    size_t power_sizes[LIMB_BITS];
+    size_t levels = 1;
+    powers[0] = limbs_alloc(1);
+    powers[0][0] = DECIMAL_CHUNK_BASE;
+    power_sizes[0] = 1;
+    while(2 * power_sizes[levels - 1] - 1 <= num->size) {
+        size_t pn = power_sizes[levels - 1];
+        powers[levels] = limbs_alloc(2 * pn);
+        limbs_sqr(powers[levels], powers[levels - 1], pn);
+        power_sizes[levels] = limbs_normalized_size(powers[levels], 2 * pn);
+        levels++;
+    }
+
+    size_t total = (size_t)1 << levels;
+    limb_t *chunks = limbs_alloc(total);
+    split_chunks(num->limbs, num->size, powers, power_sizes, levels, chunks);
+    for(size_t i = 0; i < levels; i++) {
+        free(powers[i]);
+    }
+
+    while(total > 1 && chunks[total - 1] == 0) {
+        total--;
+    }
+    *count = total;
+    return chunks;
+}
+#endif
+
+/**
+ * @brief Writes decimal chunks as text
+ * @param chunks Chunks, least significant first, top chunk non-zero
+ * @param count Number of chunks
+ * @param negative Whether to prefix '-'
+ * @param buf Output, or NULL to only measure
+ * @return Length of the text without the terminator
+ */
+static size_t format_chunks(const limb_t *chunks, size_t count, bool negative, char *buf) {
+    // The top chunk is written without padding
+    size_t top_digits = 1;
+    for(limb_t top = chunks[count - 1]; top >= 10; top /= 10) {
+        top_digits++;
+    }
+
+    size_t len = (negative ? 1 : 0) + top_digits + (count - 1) * DECIMAL_CHUNK_DIGITS;
+    if(!buf) {
+        return len;
+    }
+
+    char *p = buf;
+    if(negative) {
+        *p++ = '-';
+    }
+    write_chunk(p, chunks[count - 1], top_digits);
+    p += top_digits;
+    for(size_t i = count - 1; i-- > 0;) {
+        write_full_chunk(p, chunks[i]);
+        p += DECIMAL_CHUNK_DIGITS;
+    }
+    *p = '\0';
+    return len;
+}
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+/** Chunk buffer the caller provides for small values (unused) */
+#define SMALL_CHUNKS 1
+#else
+/** Chunk buffer the caller provides for values up to FORMAT_DC_THRESHOLD */
+#define SMALL_CHUNKS MAX_CHUNKS(FORMAT_DC_THRESHOLD)
+#endif
+
+/**
+ * @brief Gets the decimal chunks of a non-zero number
+ * @param small Caller buffer of SMALL_CHUNKS limbs for small values
+ * @param count Receives the number of chunks
+ * @param heap Receives a chunk array to free(), or NULL
+ * @return Chunks, least significant first, top chunk non-zero
+ */
+static const limb_t* decimal_chunks(const ArbitraryInt *num, limb_t *small, size_t *count,
+                                    limb_t **heap) {
+    *heap = NULL;
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    // The limbs already are the decimal chunks
+    (void)small;
+    *count = num->size;
+    return num->limbs;
+#else
+    if(num->size > FORMAT_DC_THRESHOLD) {
+        *heap = split_into_chunks(num, count);
+        return *heap;
+    }
+
+    // Peel off 19-digit chunks, least significant first, on the stack
+    limb_t work[FORMAT_DC_THRESHOLD];
+    size_t n = num->size;
+    size_t chunk_count = 0;
+    memcpy(work, num->limbs, n * sizeof(limb_t));
+    while(n > 0) {
+        small[chunk_count++] = limbs_divrem_1(work, work, n, DECIMAL_CHUNK_BASE);
+        n = limbs_normalized_size(work, n);
+    }
+    *count = chunk_count;
+    return small;
+#endif
+}
+
+// Convert ArbitraryInt to decimal text
+char* arbitrary_int_to_string(const ArbitraryInt *num) {
+    if(!num || !num->limbs) {
+        return NULL;
+    }
+    if(num->size == 0) {
+        return duplicate_string("0");
+    }
+
+    limb_t small[SMALL_CHUNKS];
+    limb_t *heap;
+    size_t count;
+    const limb_t *chunks = decimal_chunks(num, small, &count, &heap);
+
+    // Size the string exactly, then write every chunk in place
+    size_t len = format_chunks(chunks, count, num->is_negative, NULL);
+    char *str = malloc(len + 1);
+    if(str) {
+        format_chunks(chunks, count, num->is_negative, str);
+    }
+    free(heap);
+    return str;
+}
+
+size_t to_decimal_string(const ArbitraryInt *num, char *buf, size_t cap) {
+    if(!num || !num->limbs) {
+        return 0;
+    }
+    if(num->size == 0) {
+        if(cap >= 2) {
+            memcpy(buf, "0", 2);
+        }
+        return 1;
+    }
+
+    limb_t small[SMALL_CHUNKS];
+    limb_t *heap;
+    size_t count;
+    const limb_t *chunks = decimal_chunks(num, small, &count, &heap);
+
+    size_t len = format_chunks(chunks, count, num->is_negative, NULL);
+    if(len < cap) {
+        format_chunks(chunks, count, num->is_negative, buf);
+    }
+    free(heap);
+    return len;
 }
 
 // Print ArbitraryInt
@@ -160,178 +663,135 @@ void print_arbitrary_int(const ArbitraryInt *num) {
         printf("NULL");
         return;
     }
-    if (!num->value) {
+    if (!num->limbs) {
         printf("Invalid");
         return;
     }
-    
-    if (num->is_negative) {
-        printf("-");
+
+    char *str = arbitrary_int_to_string(num);
+    if (!str) {
+        printf("Invalid");
+        return;
     }
-    printf("%s", num->value);
+    fputs(str, stdout);
+    free(str);
 }
 
-// Subtraction of absolute values (a >= b)
-static char* subtract_absolute(const char *a, const char *b) {
-    size_t len_a = strlen(a);
-    size_t len_b = strlen(b);
-    char *result = calloc(len_a +1, sizeof(char)); // +1 for '\0'
+/**
+ * @brief Adds absolute values of two numbers
+ * @param a Number with at least as many limbs as b
+ * @param b Second number
+ * @return Sum |a| + |b| as new ArbitraryInt* or NULL on error
+ */
+static ArbitraryInt* add_absolute(const ArbitraryInt *a, const ArbitraryInt *b) {
+    ArbitraryInt *result = allocate_arbitrary_int(a->size + 1);
     if(!result) {
-        perror("Failed to allocate memory for subtraction");
-        exit(EXIT_FAILURE);
-    }
-
-    int borrow = 0, diff;
-    int digit_a, digit_b;
-    for(int i = 0; i < len_a; i++) {
-        digit_a = (len_a -1 -i >=0) ? (a[len_a -1 -i] - '0') : 0;
-        digit_b = (i < len_b) ? (b[len_b -1 -i] - '0') : 0;
-        diff = digit_a - digit_b - borrow;
-        if(diff < 0) {
-            diff +=10;
-            borrow =1;
-        } else {
-            borrow =0;
-        }
-        result[i] = diff + '0';
+        return NULL;
     }
 
-    // Remove trailing zeros
-    int new_len = len_a;
-    while(new_len >1 && result[new_len -1] == '0') {
-        new_len--;
-    }
-    result[new_len] = '\0';
-    reverse_str(result);
-    char *trimmed = remove_leading_zeros(result);
-    free(result);
-    return trimmed;
+    limb_t carry = limbs_add(result->limbs, a->limbs, a->size, b->limbs, b->size);
+    result->limbs[a->size] = carry;
+    result->size = a->size + (carry != 0);
+    return result;
 }
 
-// Addition function
-ArbitraryInt* add_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
-    if (!a || !b || !a->value || !b->value) {
+/**
+ * @brief Subtracts absolute values of two numbers
+ * @param a Number with |a| >= |b|
+ * @param b Second number
+ * @return Difference |a| - |b| as new ArbitraryInt* or NULL on error
+ */
+static ArbitraryInt* subtract_absolute(const ArbitraryInt *a, const ArbitraryInt *b) {
+    ArbitraryInt *result = allocate_arbitrary_int(a->size);
+    if(!result) {
         return NULL;
     }
 
-    ArbitraryInt *result = malloc(sizeof(ArbitraryInt));
-    if(!result) {
+    limbs_sub(result->limbs, a->limbs, a->size, b->limbs, b->size);
+    result->size = a->size;
+    normalize_arbitrary_int(result);
+    return result;
+}
+
+// Addition function
+ArbitraryInt* add_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
+    if (!a || !b || !a->limbs || !b->limbs) {
         return NULL;
     }
 
-    // Initialize
-    result->is_negative = false;
-    result->value = NULL;
-
+    ArbitraryInt *result;
     if(a->is_negative == b->is_negative) {
         // Same sign: add absolute values
-        char *sum = add_absolute(a->value, b->value);
-        if (!sum) {
-            free(result);
+        result = (a->size >= b->size) ? add_absolute(a, b) : add_absolute(b, a);
+        if (!result) {
             return NULL;
         }
-        result->value = sum;
         result->is_negative = a->is_negative;
     } else {
         // Different signs: subtract smaller absolute from larger absolute
-        int cmp = compare_arbitrary_ints(a, b);
+        int cmp = compare_arbitrary_int_magnitudes(a, b);
         if(cmp == 0) {
             // Result is zero
-            result->value = strdup("0");
-            result->is_negative = false;
+            return allocate_arbitrary_int(1);
         } else if(cmp > 0) {
             // |a| > |b|
-            result->value = subtract_absolute(a->value, b->value);
+            result = subtract_absolute(a, b);
+            if (!result) {
+                return NULL;
+            }
             result->is_negative = a->is_negative;
         } else {
             // |b| > |a|
-            result->value = subtract_absolute(b->value, a->value);
+            result = subtract_absolute(b, a);
+            if (!result) {
+                return NULL;
+            }
             result->is_negative = b->is_negative;
         }
     }
 
+    normalize_arbitrary_int(result);
     return result;
 }
 
 // Subtraction function (a - b)
 ArbitraryInt* subtract_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
-    // Subtracting b is equivalent to adding (-b)
-    ArbitraryInt neg_b = {
-        .is_negative = !b->is_negative,
-        .value = strdup(b->value)
-    };
+    if (!a || !b) {
+        return NULL;
+    }
 
-    ArbitraryInt *result = add_arbitrary_ints(a, &neg_b);
+    // Subtracting b is equivalent to adding (-b); the view shares b's limbs
+    ArbitraryInt neg_b = *b;
+    neg_b.is_negative = !b->is_negative;
 
-    free(neg_b.value);
-    return result;
+    return add_arbitrary_ints(a, &neg_b);
 }
 
-// Helper function for multiplication
-static char* multiply_by_digit(const char *num, int digit) {
-    if(digit == 0) return strdup("0");
-    
-    size_t len = strlen(num);
-    char *result = calloc(len + 2, sizeof(char));
-    if(!result) {
-        perror("Failed to allocate memory for multiplication");
-        exit(EXIT_FAILURE);
+ArbitraryInt* multiply_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
+    if (!a || !b || !a->limbs || !b->limbs) {
+        return NULL;
     }
 
-    int carry = 0;
-    for(int i = len - 1; i >= 0; i--) {
-        int prod = (num[i] - '0') * digit + carry;
-        result[i + 1] = (prod % 10) + '0';
-        carry = prod / 10;
+    // Handle zero multiplication
+    if(a->size == 0 || b->size == 0) {
+        return allocate_arbitrary_int(1);
     }
-    
-    if(carry > 0) {
-        result[0] = carry + '0';
+
+    ArbitraryInt *result = allocate_arbitrary_int(a->size + b->size);
+    if(!result) {
+        return NULL;
+    }
+
+    if(a->size >= b->size) {
+        limbs_mul(result->limbs, a->limbs, a->size, b->limbs, b->size);
     } else {
-        memmove(result, result + 1, len + 1);
+        limbs_mul(result->limbs, b->limbs, b->size, a->limbs, a->size);
     }
-    
-    return result;
-}
+    result->size = a->size + b->size;
 
-ArbitraryInt* multiply_arbitrary_ints(const ArbitraryInt *a, const ArbitraryInt *b) {
-    // Handle zero multiplication
-    if(strcmp(a->value, "0") == 0 || strcmp(b->value, "0") == 0) {
-        return create_arbitrary_int("0");
-    }
-
-    size_t len_a = strlen(a->value);
-    size_t len_b = strlen(b->value);
-    
-    // Initialize result as "0"
-    ArbitraryInt *result = create_arbitrary_int("0");
-    
-    // Multiply each digit of b with a
-    for(size_t i = 0; i < len_b; i++) {
-        int digit = b->value[len_b - 1 - i] - '0';
-        char *partial = multiply_by_digit(a->value, digit);
-        
-        // Add zeros at the end based on position
-        for(size_t j = 0; j < i; j++) {
-            size_t len = strlen(partial);
-            partial = realloc(partial, len + 2);
-            partial[len] = '0';
-            partial[len + 1] = '\0';
-        }
-        
-        // Add to result
-        ArbitraryInt *temp = create_arbitrary_int(partial);
-        ArbitraryInt *new_result = add_arbitrary_ints(result, temp);
-        
-        free(partial);
-        free_arbitrary_int(temp);
-        free_arbitrary_int(result);
-        result = new_result;
-    }
-    
     // Set sign
     result->is_negative = (a->is_negative != b->is_negative);
-    
+    normalize_arbitrary_int(result);
+
     return result;
 }
-
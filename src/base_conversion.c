@@ -8,45 +8,363 @@
 
 #include "base_conversion.h"
 #include "operations.h"
+#include "limb_ops.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 /** Lookup table for digit characters (0-9, A-Z) */
 static const char digits_map[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
+/**
+ * Digit value of every byte: 0-9, then A-Z and a-z as 10-35. Anything
+ * else maps to 36, which is out of range for every base.
+ */
+static const unsigned char digit_values[256] = {
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 36, 36, 36, 36, 36, 36,
+    36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+    36, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+    25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36,
+    36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36
+};
+
 /**
  * @brief Converts a single character to its numerical value
  * @param c Character to convert
  * @return Numerical value (0-35) or -1 if invalid
  */
 int char_to_value(char c) {
-    int val = -1;
-    
-    // Handle decimal digits
-    if (c >= '0' && c <= '9') {
-        val = c - '0';
+    int val = digit_values[(unsigned char)c];
+    return val < 36 ? val : -1;
+}
+
+/**
+ * @brief Finds the first character that is not a digit in the base
+ * @param str Characters to check
+ * @param len Number of characters
+ * @param base Base (2-36)
+ * @return Index of the first invalid character, or len if all are valid
+ *
+ * With SSE2, sixteen characters are range-checked per step against the
+ * digit and letter ranges of the base (letters folded to lowercase), and
+ * only a block that fails is rescanned byte by byte.
+ */
+static size_t find_invalid_digit(const char *str, size_t len, int base) {
+    size_t i = 0;
+#ifdef __SSE2__
+    int digit_count = base < 10 ? base : 10;
+    int letter_count = base > 10 ? base - 10 : 0;
+    const __m128i digit_low = _mm_set1_epi8('0' - 1);
+    const __m128i digit_high = _mm_set1_epi8((char)('0' + digit_count));
+    const __m128i letter_low = _mm_set1_epi8('a' - 1);
+    const __m128i letter_high = _mm_set1_epi8((char)('a' + letter_count));
+    const __m128i fold = _mm_set1_epi8(0x20);
+    for(; i + 16 <= len; i += 16) {
+        // Bytes >= 0x80 compare as negative and fail both ranges
+        __m128i block = _mm_loadu_si128((const __m128i *)(str + i));
+        __m128i lower = _mm_or_si128(block, fold);
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(block, digit_low),
+                                      _mm_cmplt_epi8(block, digit_high));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, letter_low),
+                                       _mm_cmplt_epi8(lower, letter_high));
+        if(_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xFFFF) {
+            break;
+        }
+    }
+#endif
+    for(; i < len; i++) {
+        if(digit_values[(unsigned char)str[i]] >= base) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Powers of the chunk base used to split a number for to_base
+ *
+ * A chunk is the largest power of the base that fits in one limb, so a
+ * single-limb division peels chunk_digits digits at once; powers[i] is
+ * chunk_base^(2^i) and covers chunk_digits << i digits.
+ */
+typedef struct {
+    int base;                /**< Output base */
+    size_t chunk_digits;     /**< Digits per chunk */
+    limb_t chunk_base;       /**< base^chunk_digits */
+    ArbitraryInt **powers;   /**< chunk_base^(2^i) */
+    size_t count;            /**< Number of powers built */
+} PowerTree;
+
+/**
+ * @brief Writes a small number's digits by repeated single-limb division
+ * @param x Value to write
+ * @param tree Chunk parameters
+ * @param out Output position
+ * @param width Digits to write with zero padding, or 0 for no padding
+ * @return Number of digits written
+ */
+static size_t write_leaf(const ArbitraryInt *x, const PowerTree *tree, char *out, size_t width) {
+    size_t n = x->size;
+    size_t capacity = width ? width : n * LIMB_BITS + 1;
+    char *buffer = width ? out : malloc(capacity);
+    limb_t *work = limbs_alloc(n ? n : 1);
+    if(!buffer) {
+        fprintf(stderr, "Memory allocation failed\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(work, x->limbs, n * sizeof(limb_t));
+
+    // Fill from the least significant end; only the top chunk is unpadded
+    char *pos = buffer + capacity;
+    while(n > 0) {
+        limb_t chunk = limbs_divrem_1(work, work, n, tree->chunk_base);
+        n = limbs_normalized_size(work, n);
+        for(size_t i = 0; i < tree->chunk_digits && (n > 0 || chunk > 0); i++) {
+            *--pos = digits_map[chunk % (limb_t)tree->base];
+            chunk /= (limb_t)tree->base;
+        }
+    }
+    free(work);
+
+    if(width) {
+        memset(buffer, '0', (size_t)(pos - buffer));
+        return width;
+    }
+    if(pos == buffer + capacity) {
+        *--pos = '0';
+    }
+    size_t len = (size_t)(buffer + capacity - pos);
+    memcpy(out, pos, len);
+    free(buffer);
+    return len;
+}
+
+/**
+ * @brief Writes x < powers[level] as exactly chunk_digits << level digits
+ * @return true on success, false if a division failed
+ */
+static bool write_padded(const ArbitraryInt *x, const PowerTree *tree, size_t level, char *out) {
+    size_t width = tree->chunk_digits << level;
+    if(level == 0 || tree->powers[level]->size <= TO_BASE_DC_THRESHOLD) {
+        write_leaf(x, tree, out, width);
+        return true;
+    }
+
+    ArbitraryInt *low;
+    ArbitraryInt *high = divide(x, tree->powers[level - 1], &low);
+    bool ok = high && low &&
+              write_padded(high, tree, level - 1, out) &&
+              write_padded(low, tree, level - 1, out + width / 2);
+    free_arbitrary_int(high);
+    free_arbitrary_int(low);
+    return ok;
+}
+
+/**
+ * @brief Writes x < powers[level]^2 without leading zeros
+ * @param len Receives the number of digits written
+ * @return true on success, false if a division failed
+ *
+ * Splits x = high * powers[level] + low, writes high recursively and low
+ * zero padded, so the digits land in place with no reversal or copying.
+ */
+static bool write_top(const ArbitraryInt *x, const PowerTree *tree, size_t level,
+                      char *out, size_t *len) {
+    if(x->size <= TO_BASE_DC_THRESHOLD) {
+        *len = write_leaf(x, tree, out, 0);
+        return true;
+    }
+    if(compare_arbitrary_int_magnitudes(x, tree->powers[level]) < 0) {
+        return write_top(x, tree, level - 1, out, len);
+    }
+
+    ArbitraryInt *low;
+    ArbitraryInt *high = divide(x, tree->powers[level], &low);
+    size_t high_len = 0;
+    bool ok = high && low &&
+              write_top(high, tree, level - 1, out, &high_len) &&
+              write_padded(low, tree, level, out + high_len);
+    *len = high_len + (tree->chunk_digits << level);
+    free_arbitrary_int(high);
+    free_arbitrary_int(low);
+    return ok;
+}
+
+static void free_power_tree(PowerTree *tree) {
+    for(size_t i = 0; i < tree->count; i++) {
+        free_arbitrary_int(tree->powers[i]);
+    }
+    free(tree->powers);
+}
+
+/**
+ * @brief Sets up the chunk parameters and powers[0] for a base
+ * @return true on success, false on allocation failure
+ */
+static bool init_power_tree(PowerTree *tree, int base) {
+    tree->base = base;
+    tree->chunk_digits = 1;
+    tree->chunk_base = (limb_t)base;
+    while(tree->chunk_base <= LIMB_MAX / (limb_t)base) {
+        tree->chunk_base *= (limb_t)base;
+        tree->chunk_digits++;
+    }
+
+    tree->count = 0;
+    tree->powers = malloc(LIMB_BITS * sizeof(ArbitraryInt*));
+    if(!tree->powers) {
+        return false;
+    }
+    tree->powers[tree->count++] = create_arbitrary_int_from_uint(tree->chunk_base);
+    return tree->powers[0] != NULL;
+}
+
+/**
+ * @brief Appends powers[count] = powers[count-1]^2
+ * @return true on success, false on allocation failure
+ */
+static bool grow_power_tree(PowerTree *tree) {
+    ArbitraryInt *next = square(tree->powers[tree->count - 1]);
+    if(!next) {
+        return false;
+    }
+    tree->powers[tree->count++] = next;
+    return true;
+}
+
+/**
+ * @brief Builds powers until powers[count-1]^2 exceeds x
+ * @return true on success, false on allocation failure
+ */
+static bool build_power_tree(PowerTree *tree, int base, const ArbitraryInt *x) {
+    if(!init_power_tree(tree, base)) {
+        return false;
+    }
+    while(x->size > TO_BASE_DC_THRESHOLD &&
+          2 * tree->powers[tree->count - 1]->size - 1 <= x->size) {
+        if(!grow_power_tree(tree)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Upper bound on the digit count of a non-zero magnitude in a base
+ *
+ * x < (top + 1) * radix^(size-1), so the bound is off by at most one or
+ * two characters.
+ */
+static size_t digit_bound(const ArbitraryInt *x, int base) {
+    double radix = (double)limb_join(1, 0);
+    double log_x = log((double)x->limbs[x->size - 1] + 1.0) + (double)(x->size - 1) * log(radix);
+    return (size_t)(log_x / log((double)base)) + 2;
+}
+
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+/**
+ * @brief Bits per digit when base is 2, 4, 8, 16 or 32, otherwise 0
+ */
+static int power_of_two_bits(int base) {
+    return (base & (base - 1)) == 0 && base <= 32 ? __builtin_ctz((unsigned)base) : 0;
+}
+
+/**
+ * @brief Writes a non-zero number in base 2^bits by slicing its limbs
+ * @param num Number to convert
+ * @param bits Bits per digit (1 to 5)
+ * @return String representation or NULL on allocation failure
+ *
+ * Each digit is read straight from the bits of the binary limbs, so the
+ * conversion is a single linear pass with no arithmetic on the number.
+ */
+static char* to_base_pow2(const ArbitraryInt *num, int bits) {
+    limb_t top = num->limbs[num->size - 1];
+    size_t nbits = (num->size - 1) * LIMB_BITS + (size_t)(LIMB_BITS - __builtin_clzll(top));
+    size_t ndigits = (nbits + (size_t)bits - 1) / (size_t)bits;
+    size_t sign = num->is_negative ? 1 : 0;
+
+    char *result = malloc(sign + ndigits + 1);
+    if(!result) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
     }
-    // Handle uppercase hex digits
-    else if (c >= 'A' && c <= 'F') {
-        val = 10 + (c - 'A');
+
+    limb_t mask = ((limb_t)1 << bits) - 1;
+    char *out = result + sign + ndigits;
+    *out = '\0';
+    for(size_t pos = 0; pos < nbits; pos += (size_t)bits) {
+        size_t index = pos / LIMB_BITS;
+        size_t offset = pos % LIMB_BITS;
+        limb_t value = num->limbs[index] >> offset;
+        if(offset + (size_t)bits > LIMB_BITS && index + 1 < num->size) {
+            value |= num->limbs[index + 1] << (LIMB_BITS - offset);
+        }
+        *--out = digits_map[value & mask];
+    }
+    if(sign) {
+        result[0] = '-';
+    }
+    return result;
+}
+
+/**
+ * @brief Parses validated digits in base 2^bits by placing their bits
+ * @param str Digits without sign or leading zeros
+ * @param len Number of digits
+ * @param bits Bits per digit (1 to 5)
+ * @return New non-negative ArbitraryInt or NULL on allocation failure
+ */
+static ArbitraryInt* from_base_pow2(const char *str, size_t len, int bits) {
+    size_t nlimbs = (len * (size_t)bits + LIMB_BITS - 1) / LIMB_BITS;
+    ArbitraryInt *num = allocate_arbitrary_int(nlimbs);
+    if(!num) {
+        return NULL;
     }
-    // Handle lowercase hex digits
-    else if (c >= 'a' && c <= 'f') {
-        val = 10 + (c - 'a');
+    memset(num->limbs, 0, nlimbs * sizeof(limb_t));
+    num->size = nlimbs;
+
+    size_t pos = 0;
+    for(size_t i = len; i-- > 0; pos += (size_t)bits) {
+        limb_t value = digit_values[(unsigned char)str[i]];
+        size_t index = pos / LIMB_BITS;
+        size_t offset = pos % LIMB_BITS;
+        num->limbs[index] |= value << offset;
+        if(offset + (size_t)bits > LIMB_BITS) {
+            num->limbs[index + 1] |= value >> (LIMB_BITS - offset);
+        }
     }
-    
-    // Debug output
-    printf("Converting '%c' to value: %d\n", c, val);
-    return val;
+    normalize_arbitrary_int(num);
+    return num;
 }
+#endif
 
 /**
- * @brief Converts a decimal number to specified base
+ * @brief Converts a number to the specified base
  * @param num Number to convert
  * @param base Target base (2-36)
  * @return String representation in target base or NULL on error
+ *
+ * Divide and conquer: the number is split by powers base^(k*2^i) with
+ * fast division, and each half is written into its place in the output.
+ * Runs in O(M(n) log n) for M(n) the cost of an n-limb multiplication.
+ * With binary limbs, bases 2, 4, 8, 16 and 32 are sliced out in linear time.
  */
 char* to_base(const ArbitraryInt *num, int base) {
     if(base < 2 || base > 36) {
@@ -54,50 +372,119 @@ char* to_base(const ArbitraryInt *num, int base) {
         return NULL;
     }
 
-    if(strcmp(num->value, "0") == 0) {
+    if(is_arbitrary_int_zero(num)) {
         return strdup("0");
     }
 
-    bool is_negative = num->is_negative;
-    ArbitraryInt *temp = copy_arbitrary_int(num);
-    temp->is_negative = false;
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+    if(power_of_two_bits(base)) {
+        return to_base_pow2(num, power_of_two_bits(base));
+    }
+#endif
 
-    char *result = malloc(1000);
-    int pos = 0;
+    // Convert the magnitude through a sign-less view
+    ArbitraryInt magnitude = *num;
+    magnitude.is_negative = false;
 
-    ArbitraryInt *base_ai = create_arbitrary_int("0");
-    char base_str[20];
-    sprintf(base_str, "%d", base);
-    free_arbitrary_int(base_ai);
-    base_ai = create_arbitrary_int(base_str);
+    PowerTree tree;
+    char *result = NULL;
+    if(build_power_tree(&tree, base, &magnitude)) {
+        result = malloc(digit_bound(&magnitude, base) + 2);
+    }
+    if(!result) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free_power_tree(&tree);
+        return NULL;
+    }
 
-    while(strcmp(temp->value, "0") != 0) {
-        ArbitraryInt *remainder;
-        ArbitraryInt *quotient = divide(temp, base_ai, &remainder);
-        
-        int rem_val = atoi(remainder->value);
-        result[pos++] = digits_map[rem_val];
-        
-        free_arbitrary_int(temp);
-        free_arbitrary_int(remainder);
-        temp = quotient;
+    size_t pos = 0;
+    if(num->is_negative) {
+        result[pos++] = '-';
+    }
+    size_t len = 0;
+    if(!write_top(&magnitude, &tree, tree.count - 1, result + pos, &len)) {
+        free(result);
+        result = NULL;
+    } else {
+        result[pos + len] = '\0';
     }
 
-    free_arbitrary_int(temp);
-    free_arbitrary_int(base_ai);
+    free_power_tree(&tree);
+    return result;
+}
 
-    if(is_negative) {
-        result[pos++] = '-';
+/**
+ * @brief Parses a short digit string by folding in one chunk at a time
+ * @param str Validated digits, most significant first
+ * @param len Number of digits
+ * @return New non-negative ArbitraryInt or NULL on allocation failure
+ */
+static ArbitraryInt* parse_leaf(const char *str, size_t len, const PowerTree *tree) {
+    ArbitraryInt *num = allocate_arbitrary_int(len / tree->chunk_digits + 1);
+    if(!num) {
+        return NULL;
     }
-    result[pos] = '\0';
-    
-    // Reverse the string
-    for(int i = 0; i < pos/2; i++) {
-        char tmp = result[i];
-        result[i] = result[pos-1-i];
-        result[pos-1-i] = tmp;
+
+    // num = num * chunk_base + chunk, with a short first chunk if needed
+    size_t chunk_len = len % tree->chunk_digits;
+    if(chunk_len == 0) {
+        chunk_len = tree->chunk_digits;
     }
+    for(size_t pos = 0; pos < len; pos += chunk_len, chunk_len = tree->chunk_digits) {
+        limb_t chunk = 0;
+        limb_t scale = 1;
+        for(size_t i = 0; i < chunk_len; i++) {
+            chunk = chunk * (limb_t)tree->base + digit_values[(unsigned char)str[pos + i]];
+            scale *= (limb_t)tree->base;
+        }
 
+        limb_t carry = limbs_mul_1(num->limbs, num->limbs, num->size, scale);
+        if(carry) {
+            num->limbs[num->size++] = carry;
+        }
+        carry = limbs_add_1(num->limbs, num->limbs, num->size, chunk);
+        if(carry) {
+            num->limbs[num->size++] = carry;
+        }
+    }
+    normalize_arbitrary_int(num);
+    return num;
+}
+
+/**
+ * @brief Parses validated digits by splitting off powers of the chunk base
+ * @param str Digits, most significant first
+ * @param len Number of digits
+ * @param tree Powers of the chunk base, grown on demand
+ * @return New non-negative ArbitraryInt or NULL on allocation failure
+ *
+ * The low chunk_digits << i digits, for the largest such block shorter
+ * than len, are parsed separately and combined as high * powers[i] + low.
+ */
+static ArbitraryInt* parse_digits(const char *str, size_t len, PowerTree *tree) {
+    if(len <= tree->chunk_digits * FROM_BASE_DC_THRESHOLD) {
+        return parse_leaf(str, len, tree);
+    }
+
+    size_t level = 0;
+    while((tree->chunk_digits << (level + 1)) < len) {
+        level++;
+    }
+    while(tree->count <= level) {
+        if(!grow_power_tree(tree)) {
+            return NULL;
+        }
+    }
+
+    size_t low_len = tree->chunk_digits << level;
+    ArbitraryInt *high = parse_digits(str, len - low_len, tree);
+    ArbitraryInt *low = parse_digits(str + len - low_len, low_len, tree);
+    ArbitraryInt *scaled = high && low ? multiply(high, tree->powers[level]) : NULL;
+    ArbitraryInt *result = scaled ? add(scaled, low) : NULL;
+
+    free_arbitrary_int(high);
+    free_arbitrary_int(low);
+    free_arbitrary_int(scaled);
     return result;
 }
 
@@ -106,18 +493,15 @@ char* to_base(const ArbitraryInt *num, int base) {
  * @param str String representation in source base
  * @param base Source base (2-36)
  * @return Decimal ArbitraryInt* or NULL on error
+ *
+ * Digits are validated up front, then parsed a limb-sized chunk at a time
+ * and combined in a balanced tree with powers of the base, so long inputs
+ * cost O(M(n) log n) instead of one full multiplication per digit. With
+ * binary limbs, bases 2, 4, 8, 16 and 32 are placed bit by bit instead.
  */
 ArbitraryInt* from_base(const char *str, int base) {
-    printf("Converting string '%s' from base %d\n", str, base);
-    
     if (!str || base < 2 || base > 36) {
-        printf("Invalid input: str=%p, base=%d\n", (void*)str, base);
-        return NULL;
-    }
-
-    // Handle empty string
-    if (strlen(str) == 0) {
-        printf("Empty string input\n");
+        fprintf(stderr, "Invalid input for base %d\n", base);
         return NULL;
     }
 
@@ -126,73 +510,44 @@ ArbitraryInt* from_base(const char *str, int base) {
     if (str[0] == '-') {
         is_negative = true;
         str++;  // Skip the minus sign
-        printf("Negative number detected, processing: %s\n", str);
     }
 
-    // Create result starting at 0
-    ArbitraryInt *result = create_arbitrary_int("0");
-    if (!result) {
-        printf("Failed to create initial result\n");
+    size_t len = strlen(str);
+    if (len == 0) {
+        fprintf(stderr, "Empty string input\n");
         return NULL;
     }
 
-    // Create base number for multiplication
-    char base_str[20];
-    sprintf(base_str, "%d", base);
-    ArbitraryInt *base_num = create_arbitrary_int(base_str);
-    if (!base_num) {
-        printf("Failed to create base number\n");
-        free_arbitrary_int(result);
+    size_t invalid = find_invalid_digit(str, len, base);
+    if (invalid < len) {
+        fprintf(stderr, "Invalid digit '%c' for base %d\n", str[invalid], base);
         return NULL;
     }
 
-    // Process each digit
-    for (const char *p = str; *p; p++) {
-        printf("Processing digit: '%c'\n", *p);
-        
-        // Convert character to value
-        int val = char_to_value(*p);
-        if (val < 0 || val >= base) {
-            printf("Invalid digit '%c' for base %d (val=%d)\n", *p, base, val);
-            free_arbitrary_int(result);
-            free_arbitrary_int(base_num);
-            return NULL;
-        }
-
-        // result = result * base + val
-        ArbitraryInt *temp = multiply(result, base_num);
-        if (!temp) {
-            free_arbitrary_int(result);
-            free_arbitrary_int(base_num);
-            return NULL;
-        }
-
-        // Convert val to ArbitraryInt
-        char val_str[20];
-        sprintf(val_str, "%d", val);
-        ArbitraryInt *val_num = create_arbitrary_int(val_str);
-        if (!val_num) {
-            free_arbitrary_int(temp);
-            free_arbitrary_int(base_num);
-            free_arbitrary_int(result);
-            return NULL;
-        }
+    // Skip leading zeros
+    while (len > 1 && *str == '0') {
+        str++;
+        len--;
+    }
 
-        // Add the value
-        ArbitraryInt *new_result = add(temp, val_num);
-        free_arbitrary_int(temp);
-        free_arbitrary_int(val_num);
-        free_arbitrary_int(result);
-        
-        if (!new_result) {
-            free_arbitrary_int(base_num);
-            return NULL;
+    ArbitraryInt *result = NULL;
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+    if (power_of_two_bits(base)) {
+        result = from_base_pow2(str, len, power_of_two_bits(base));
+    } else
+#endif
+    {
+        PowerTree tree;
+        if (init_power_tree(&tree, base)) {
+            result = parse_digits(str, len, &tree);
         }
-        
-        result = new_result;
+        free_power_tree(&tree);
+    }
+    if (!result) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return NULL;
     }
 
-    free_arbitrary_int(base_num);
-    result->is_negative = is_negative;
+    result->is_negative = is_negative && result->size > 0;
     return result;
-}
\ No newline at end of file
+}
@@ -3,7 +3,7 @@
  * 
  * This module implements rational number arithmetic using arbitrary precision
  * integers. Features include:
- * - Automatic fraction simplification using GCD
+ * - Automatic fraction simplification using GCD, eager or deferred
  * - Support for improper fractions (e.g., 5/4)
  * - Basic arithmetic operations (+, -, *, /)
  * - Proper sign handling
@@ -16,32 +16,242 @@
 #include <string.h>
 
 /**
- * gcd - Calculate Greatest Common Divisor
- * @a: First arbitrary integer
- * @b: Second arbitrary integer
+ * fraction_limbs - Combined size of both parts of a fraction
+ */
+static size_t fraction_limbs(const Fraction *frac) {
+    return frac->numerator->size + frac->denominator->size;
+}
+
+/**
+ * is_one - Check whether a GCD is one
+ */
+static bool is_one(const ArbitraryInt *num) {
+    return num->size == 1 && num->limbs[0] == 1;
+}
+
+/**
+ * divide_by_gcd - Exact quotient of a number by a divisor of it
+ * @num: Number to divide
+ * @g: Positive divisor of @num
+ *
+ * Return: New ArbitraryInt num/g, or NULL on error
+ */
+static ArbitraryInt* divide_by_gcd(const ArbitraryInt *num, const ArbitraryInt *g) {
+    if (!num || !g) return NULL;
+    return is_one(g) ? copy_arbitrary_int(num) : divide(num, g, NULL);
+}
+
+/**
+ * reduce_fraction - Divide both parts of a fraction by their GCD
+ * @frac: Fraction to reduce in place
+ *
+ * Return: true on success, false if an allocation failed
+ */
+static bool reduce_fraction(Fraction *frac) {
+    ArbitraryInt *gcd_value = gcd(frac->numerator, frac->denominator);
+    if (!gcd_value) return false;
+
+    if (!is_one(gcd_value)) {
+        ArbitraryInt *new_num = divide(frac->numerator, gcd_value, NULL);
+        ArbitraryInt *new_den = divide(frac->denominator, gcd_value, NULL);
+        if (!new_num || !new_den) {
+            free_arbitrary_int(new_num);
+            free_arbitrary_int(new_den);
+            free_arbitrary_int(gcd_value);
+            return false;
+        }
+
+        free_arbitrary_int(frac->numerator);
+        free_arbitrary_int(frac->denominator);
+        frac->numerator = new_num;
+        frac->denominator = new_den;
+    }
+    free_arbitrary_int(gcd_value);
+
+    frac->reduced = true;
+    frac->reduced_limbs = fraction_limbs(frac);
+    return true;
+}
+
+/**
+ * wrap_fraction - Wrap a numerator and denominator into a fraction
+ * @numerator: Top number, owned by the result
+ * @denominator: Bottom number, owned by the result
+ * @lazy: Whether the fraction defers reduction
+ *
+ * Normalizes the sign without reducing. Both parts are freed on error.
+ *
+ * Return: Pointer to new Fraction or NULL on error
+ */
+static Fraction* wrap_fraction(ArbitraryInt *numerator, ArbitraryInt *denominator, bool lazy) {
+    Fraction *result = NULL;
+    if (numerator && denominator && !is_arbitrary_int_zero(denominator)) {
+        result = malloc(sizeof(Fraction));
+    }
+    if (!result) {
+        free_arbitrary_int(numerator);
+        free_arbitrary_int(denominator);
+        return NULL;
+    }
+
+    result->numerator = numerator;
+    result->denominator = denominator;
+    result->lazy = lazy;
+    result->reduced = false;
+    result->reduced_limbs = 0;
+
+    // Handle signs
+    if (result->denominator->is_negative) {
+        result->denominator->is_negative = false;
+        result->numerator->is_negative = !result->numerator->is_negative;
+        normalize_arbitrary_int(result->numerator);
+    }
+
+    return result;
+}
+
+/**
+ * make_fraction - Wrap a numerator and denominator, reducing as needed
+ * @numerator: Top number, owned by the result
+ * @denominator: Bottom number, owned by the result
+ * @lazy: Whether the fraction defers reduction
+ * @reduced_limbs: Part sizes at the last reduction of the inputs
+ *
+ * Reduces eager fractions always and lazy ones once they have outgrown
+ * @reduced_limbs.
+ *
+ * Return: Pointer to new Fraction or NULL on error
+ */
+static Fraction* make_fraction(ArbitraryInt *numerator, ArbitraryInt *denominator,
+                               bool lazy, size_t reduced_limbs) {
+    Fraction *result = wrap_fraction(numerator, denominator, lazy);
+    if (!result) return NULL;
+    result->reduced_limbs = reduced_limbs;
+
+    if (!lazy || fraction_limbs(result) > 2 * reduced_limbs + FRACTION_LAZY_SLACK_LIMBS) {
+        if (!reduce_fraction(result)) {
+            free_fraction(result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * combine - Build the result of a binary fraction operation
+ * @a: First operand
+ * @b: Second operand
+ * @numerator: Unreduced top number, owned by the result
+ * @denominator: Unreduced bottom number, owned by the result
+ *
+ * The result is lazy if either operand is; its growth is measured against
+ * the larger operand's size at its last reduction.
+ */
+static Fraction* combine(const Fraction *a, const Fraction *b,
+                         ArbitraryInt *numerator, ArbitraryInt *denominator) {
+    size_t reduced_limbs = a->reduced_limbs > b->reduced_limbs ? a->reduced_limbs : b->reduced_limbs;
+    return make_fraction(numerator, denominator, a->lazy || b->lazy, reduced_limbs);
+}
+
+/**
+ * reduced_fraction - Wrap parts already known to be coprime
+ * @numerator: Top number, owned by the result
+ * @denominator: Bottom number, owned by the result
+ *
+ * A zero numerator gets the denominator 1.
+ */
+static Fraction* reduced_fraction(ArbitraryInt *numerator, ArbitraryInt *denominator) {
+    if (numerator && denominator && is_arbitrary_int_zero(numerator)) {
+        free_arbitrary_int(denominator);
+        denominator = create_arbitrary_int_from_uint(1);
+    }
+
+    Fraction *result = wrap_fraction(numerator, denominator, false);
+    if (result) {
+        result->reduced = true;
+        result->reduced_limbs = fraction_limbs(result);
+    }
+    return result;
+}
+
+/**
+ * henrici_add - Add or subtract two fractions in lowest terms
+ * @a: First fraction
+ * @b: Second fraction
+ * @op: add or subtract
  *
- * Uses Euclidean algorithm to find GCD for fraction simplification.
- * Handles signs by converting to absolute values first.
+ * With g = gcd(b, d), a/b + c/d = t / ((b/g)(d/g2)) for t = a(d/g) + c(b/g)
+ * and g2 = gcd(t, g), so the GCDs only see the smaller values. Equal
+ * denominators skip straight to gcd(a + c, b).
  *
- * Return: ArbitraryInt* containing the GCD
+ * Return: Pointer to new Fraction in lowest terms
  */
-static ArbitraryInt* gcd(const ArbitraryInt *a, const ArbitraryInt *b) {
-    ArbitraryInt *temp_a = copy_arbitrary_int(a);
-    ArbitraryInt *temp_b = copy_arbitrary_int(b);
-    
-    // Make absolute values for GCD
-    temp_a->is_negative = false;
-    temp_b->is_negative = false;
-    
-    while(strcmp(temp_b->value, "0") != 0) {
-        ArbitraryInt *remainder = modulo(temp_a, temp_b);
-        free_arbitrary_int(temp_a);
-        temp_a = temp_b;
-        temp_b = remainder;
+static Fraction* henrici_add(const Fraction *a, const Fraction *b,
+                             ArbitraryInt* (*op)(const ArbitraryInt *, const ArbitraryInt *)) {
+    if (compare_arbitrary_ints(a->denominator, b->denominator) == 0) {
+        ArbitraryInt *t = op(a->numerator, b->numerator);
+        ArbitraryInt *g = t ? gcd(t, a->denominator) : NULL;
+        Fraction *result = reduced_fraction(divide_by_gcd(t, g), divide_by_gcd(a->denominator, g));
+        free_arbitrary_int(t);
+        free_arbitrary_int(g);
+        return result;
     }
-    
-    free_arbitrary_int(temp_b);
-    return temp_a;
+
+    ArbitraryInt *g = gcd(a->denominator, b->denominator);
+    ArbitraryInt *b1 = divide_by_gcd(a->denominator, g);
+    ArbitraryInt *d1 = divide_by_gcd(b->denominator, g);
+
+    // (a/b + c/d) = (a*d1 + c*b1) / (b1*d1*g)
+    ArbitraryInt *ad1 = multiply(a->numerator, d1);
+    ArbitraryInt *cb1 = multiply(b->numerator, b1);
+    ArbitraryInt *t = op(ad1, cb1);
+    ArbitraryInt *g2 = t && g ? gcd(t, g) : NULL;
+    ArbitraryInt *d2 = divide_by_gcd(b->denominator, g2);
+
+    Fraction *result = reduced_fraction(divide_by_gcd(t, g2), multiply(b1, d2));
+
+    free_arbitrary_int(g);
+    free_arbitrary_int(b1);
+    free_arbitrary_int(d1);
+    free_arbitrary_int(ad1);
+    free_arbitrary_int(cb1);
+    free_arbitrary_int(t);
+    free_arbitrary_int(g2);
+    free_arbitrary_int(d2);
+    return result;
+}
+
+/**
+ * cross_cancel_multiply - Multiply two fractions in lowest terms
+ * @a: Numerator of the first factor
+ * @b: Denominator of the first factor
+ * @c: Numerator of the second factor
+ * @d: Denominator of the second factor (may be negative)
+ *
+ * Cancels g1 = gcd(a, d) and g2 = gcd(c, b) before multiplying, which
+ * leaves (a/g1)(c/g2) / ((b/g2)(d/g1)) already in lowest terms.
+ *
+ * Return: Pointer to new Fraction in lowest terms
+ */
+static Fraction* cross_cancel_multiply(const ArbitraryInt *a, const ArbitraryInt *b,
+                                       const ArbitraryInt *c, const ArbitraryInt *d) {
+    ArbitraryInt *g1 = gcd(a, d);
+    ArbitraryInt *g2 = gcd(c, b);
+    ArbitraryInt *a1 = divide_by_gcd(a, g1);
+    ArbitraryInt *b1 = divide_by_gcd(b, g2);
+    ArbitraryInt *c1 = divide_by_gcd(c, g2);
+    ArbitraryInt *d1 = divide_by_gcd(d, g1);
+
+    Fraction *result = reduced_fraction(multiply(a1, c1), multiply(b1, d1));
+
+    free_arbitrary_int(g1);
+    free_arbitrary_int(g2);
+    free_arbitrary_int(a1);
+    free_arbitrary_int(b1);
+    free_arbitrary_int(c1);
+    free_arbitrary_int(d1);
+    return result;
 }
 
 /**
@@ -55,36 +265,65 @@ static ArbitraryInt* gcd(const ArbitraryInt *a, const ArbitraryInt *b) {
  * Return: Pointer to new Fraction or NULL on error
  */
 Fraction* create_fraction(const ArbitraryInt *numerator, const ArbitraryInt *denominator) {
-    if (!numerator || !denominator || strcmp(denominator->value, "0") == 0) {
+    if (!numerator || !denominator || is_arbitrary_int_zero(denominator)) {
         return NULL;
     }
 
-    Fraction *result = malloc(sizeof(Fraction));
-    if (!result) return NULL;
-
-    result->numerator = copy_arbitrary_int(numerator);
-    result->denominator = copy_arbitrary_int(denominator);
+    return make_fraction(copy_arbitrary_int(numerator), copy_arbitrary_int(denominator), false, 0);
+}
 
-    // Simplify using GCD
-    ArbitraryInt *gcd_value = gcd(result->numerator, result->denominator);
-    if (gcd_value) {
-        ArbitraryInt *new_num = divide(result->numerator, gcd_value, NULL);
-        ArbitraryInt *new_den = divide(result->denominator, gcd_value, NULL);
-        
-        free_arbitrary_int(result->numerator);
-        free_arbitrary_int(result->denominator);
-        free_arbitrary_int(gcd_value);
-        
-        result->numerator = new_num;
-        result->denominator = new_den;
+/**
+ * create_fraction_lazy - Create a fraction that defers simplification
+ * @numerator: ArbitraryInt for numerator
+ * @denominator: ArbitraryInt for denominator
+ *
+ * The inputs are taken as they are; their size becomes the baseline for
+ * the growth check on results computed from this fraction.
+ *
+ * Return: Pointer to new Fraction or NULL on error
+ */
+Fraction* create_fraction_lazy(const ArbitraryInt *numerator, const ArbitraryInt *denominator) {
+    if (!numerator || !denominator || is_arbitrary_int_zero(denominator)) {
+        return NULL;
     }
 
-    // Handle signs
-    if (result->denominator->is_negative) {
-        result->denominator->is_negative = false;
-        result->numerator->is_negative = !result->numerator->is_negative;
+    return make_fraction(copy_arbitrary_int(numerator), copy_arbitrary_int(denominator), true,
+                         numerator->size + denominator->size);
+}
+
+/**
+ * normalize_fraction - Reduce a fraction to lowest terms
+ * @frac: Fraction to reduce in place
+ *
+ * Return: true on success, false on error
+ */
+bool normalize_fraction(Fraction *frac) {
+    if (!frac || !frac->numerator || !frac->denominator) return false;
+    return frac->reduced || reduce_fraction(frac);
+}
+
+/**
+ * compare_fractions - Compare two fractions by value
+ * @a: First fraction
+ * @b: Second fraction
+ *
+ * Denominators are positive, so a/b < c/d exactly when ad < cb.
+ *
+ * Return: -1 if a < b, 0 if equal, 1 if a > b
+ */
+int compare_fractions(const Fraction *a, const Fraction *b) {
+    if (!a || !b) return 0;
+
+    if (a->numerator->is_negative != b->numerator->is_negative) {
+        return a->numerator->is_negative ? -1 : 1;
     }
 
+    ArbitraryInt *ad = multiply(a->numerator, b->denominator);
+    ArbitraryInt *cb = multiply(b->numerator, a->denominator);
+    int result = ad && cb ? compare_arbitrary_ints(ad, cb) : 0;
+
+    free_arbitrary_int(ad);
+    free_arbitrary_int(cb);
     return result;
 }
 
@@ -93,13 +332,14 @@ Fraction* create_fraction(const ArbitraryInt *numerator, const ArbitraryInt *den
  * @a: First fraction
  * @b: Second fraction
  *
- * Implements (a/b + c/d) = (ad + bc)/(bd)
- * Result is automatically simplified.
+ * Implements (a/b + c/d) = (ad + bc)/(bd). Eager operands go through
+ * henrici_add(); lazy results are simplified only by the growth check.
  *
  * Return: Pointer to new Fraction containing sum
  */
 Fraction* add_fractions(const Fraction *a, const Fraction *b) {
     if (!a || !b) return NULL;
+    if (!a->lazy && !b->lazy) return henrici_add(a, b, add);
 
     // (a/b + c/d) = (ad + bc)/(bd)
     ArbitraryInt *ad = multiply(a->numerator, b->denominator);
@@ -107,18 +347,16 @@ Fraction* add_fractions(const Fraction *a, const Fraction *b) {
     ArbitraryInt *bd = multiply(a->denominator, b->denominator);
 
     ArbitraryInt *sum = add(ad, bc);
-    Fraction *result = create_fraction(sum, bd);
 
     free_arbitrary_int(ad);
     free_arbitrary_int(bc);
-    free_arbitrary_int(bd);
-    free_arbitrary_int(sum);
 
-    return result;
+    return combine(a, b, sum, bd);
 }
 
 Fraction* subtract_fractions(const Fraction *a, const Fraction *b) {
     if (!a || !b) return NULL;
+    if (!a->lazy && !b->lazy) return henrici_add(a, b, subtract);
 
     // (a/b - c/d) = (ad - bc)/(bd)
     ArbitraryInt *ad = multiply(a->numerator, b->denominator);
@@ -126,58 +364,193 @@ Fraction* subtract_fractions(const Fraction *a, const Fraction *b) {
     ArbitraryInt *bd = multiply(a->denominator, b->denominator);
 
     ArbitraryInt *diff = subtract(ad, bc);
-    Fraction *result = create_fraction(diff, bd);
 
     free_arbitrary_int(ad);
     free_arbitrary_int(bc);
-    free_arbitrary_int(bd);
-    free_arbitrary_int(diff);
 
-    return result;
+    return combine(a, b, diff, bd);
 }
 
 Fraction* multiply_fractions(const Fraction *a, const Fraction *b) {
     if (!a || !b) return NULL;
+    if (!a->lazy && !b->lazy) {
+        return cross_cancel_multiply(a->numerator, a->denominator, b->numerator, b->denominator);
+    }
 
     // (a/b * c/d) = (ac)/(bd)
     ArbitraryInt *ac = multiply(a->numerator, b->numerator);
     ArbitraryInt *bd = multiply(a->denominator, b->denominator);
 
-    Fraction *result = create_fraction(ac, bd);
-
-    free_arbitrary_int(ac);
-    free_arbitrary_int(bd);
-
-    return result;
+    return combine(a, b, ac, bd);
 }
 
 Fraction* divide_fractions(const Fraction *a, const Fraction *b) {
-    if (!a || !b || strcmp(b->numerator->value, "0") == 0) {
+    if (!a || !b || is_arbitrary_int_zero(b->numerator)) {
         return NULL;
     }
+    if (!a->lazy && !b->lazy) {
+        return cross_cancel_multiply(a->numerator, a->denominator, b->denominator, b->numerator);
+    }
 
     // (a/b / c/d) = (ad)/(bc)
     ArbitraryInt *ad = multiply(a->numerator, b->denominator);
     ArbitraryInt *bc = multiply(b->numerator, a->denominator);
 
-    Fraction *result = create_fraction(ad, bc);
+    return combine(a, b, ad, bc);
+}
 
-    free_arbitrary_int(ad);
-    free_arbitrary_int(bc);
+/**
+ * SeriesSplit - Partial result of binary splitting over a range
+ */
+typedef struct {
+    ArbitraryInt *p;    /* Product of ratio numerators (ratio series only) */
+    ArbitraryInt *q;    /* Common denominator */
+    ArbitraryInt *t;    /* Numerator of the partial sum over q */
+} SeriesSplit;
+
+static void free_series_split(SeriesSplit *split) {
+    free_arbitrary_int(split->p);
+    free_arbitrary_int(split->q);
+    free_arbitrary_int(split->t);
+    split->p = split->q = split->t = NULL;
+}
+
+/**
+ * series_leaf - Fetch one term from the generator
+ * @need_p: Keep p(k) as the range product (ratio series)
+ */
+static bool series_leaf(SeriesTermFn term, void *context, uint64_t k,
+                        SeriesSplit *out, bool need_p) {
+    ArbitraryInt *p = NULL;
+    ArbitraryInt *q = NULL;
+    if (!term(k, &p, &q, context) || !p || !q || is_arbitrary_int_zero(q)) {
+        free_arbitrary_int(p);
+        free_arbitrary_int(q);
+        return false;
+    }
+
+    out->q = q;
+    out->t = p;
+    out->p = need_p ? copy_arbitrary_int(p) : NULL;
+    return !need_p || out->p;
+}
+
+/**
+ * split_series - Binary splitting over begin <= k < end
+ * @ratio: Whether terms are ratios of consecutive terms
+ * @need_p: Whether the caller uses the range product P
+ *
+ * For independent terms t/q = sum of p(k)/q(k) and merging is
+ * T = T1*Q2 + T2*Q1. For ratio series the right half is scaled by the
+ * left half's P, giving T = T1*Q2 + P1*T2; P is only formed where a
+ * parent will use it, so the rightmost spine skips those products.
+ */
+static bool split_series(SeriesTermFn term, void *context, uint64_t begin, uint64_t end,
+                         bool ratio, bool need_p, SeriesSplit *out) {
+    if (end - begin == 1) {
+        return series_leaf(term, context, begin, out, ratio && need_p);
+    }
+
+    uint64_t mid = begin + (end - begin) / 2;
+    SeriesSplit left = {NULL, NULL, NULL};
+    SeriesSplit right = {NULL, NULL, NULL};
+    bool ok = split_series(term, context, begin, mid, ratio, ratio, &left) &&
+              split_series(term, context, mid, end, ratio, ratio && need_p, &right);
+
+    if (ok) {
+        ArbitraryInt *scaled = multiply(ratio ? left.p : left.q, right.t);
+        ArbitraryInt *shifted = multiply(left.t, right.q);
+        out->t = add(shifted, scaled);
+        out->q = multiply(left.q, right.q);
+        out->p = ratio && need_p ? multiply(left.p, right.p) : NULL;
+        free_arbitrary_int(scaled);
+        free_arbitrary_int(shifted);
+        ok = out->t && out->q && (!(ratio && need_p) || out->p);
+        if (!ok) free_series_split(out);
+    }
+
+    free_series_split(&left);
+    free_series_split(&right);
+    return ok;
+}
 
+/**
+ * sum_split - Run binary splitting and reduce the total once
+ */
+static Fraction* sum_split(SeriesTermFn term, void *context, uint64_t begin, uint64_t end,
+                           bool ratio) {
+    if (!term) return NULL;
+    if (begin >= end) {
+        return reduced_fraction(create_arbitrary_int_from_uint(0), create_arbitrary_int_from_uint(1));
+    }
+
+    SeriesSplit total = {NULL, NULL, NULL};
+    if (!split_series(term, context, begin, end, ratio, false, &total)) {
+        free_series_split(&total);
+        return NULL;
+    }
+
+    Fraction *result = make_fraction(total.t, total.q, false, 0);
+    free_arbitrary_int(total.p);
     return result;
 }
 
+/**
+ * sum_series - Sum independent rational terms by binary splitting
+ * @term: Generator for p(k)/q(k)
+ * @context: Passed to @term
+ * @begin: First index
+ * @end: One past the last index
+ *
+ * Return: Pointer to new Fraction in lowest terms or NULL on error
+ */
+Fraction* sum_series(SeriesTermFn term, void *context, uint64_t begin, uint64_t end) {
+    return sum_split(term, context, begin, end, false);
+}
+
+/**
+ * sum_ratio_series - Sum a series given by consecutive term ratios
+ * @ratio: Generator for p(k)/q(k), the ratio of term k to term k-1
+ * @context: Passed to @ratio
+ * @begin: First index; its ratio is the first term itself
+ * @end: One past the last index
+ *
+ * Return: Pointer to new Fraction in lowest terms or NULL on error
+ */
+Fraction* sum_ratio_series(SeriesTermFn ratio, void *context, uint64_t begin, uint64_t end) {
+    return sum_split(ratio, context, begin, end, true);
+}
+
 void print_fraction(const Fraction *frac) {
     if (!frac || !frac->numerator || !frac->denominator) {
         printf("Invalid fraction");
         return;
     }
 
+    // Lazy fractions print in lowest terms through a reduced copy
+    if (!frac->reduced && frac->lazy) {
+        Fraction *reduced = create_fraction(frac->numerator, frac->denominator);
+        if (!reduced) {
+            printf("Invalid fraction");
+            return;
+        }
+        print_fraction(reduced);
+        free_fraction(reduced);
+        return;
+    }
+
+    // Print magnitudes through sign-less views of both parts
+    ArbitraryInt abs_num = *frac->numerator;
+    ArbitraryInt abs_den = *frac->denominator;
+    abs_num.is_negative = false;
+    abs_den.is_negative = false;
+
     if (frac->numerator->is_negative != frac->denominator->is_negative) {
         printf("-");
     }
-    printf("%s/%s", frac->numerator->value, frac->denominator->value);
+    print_arbitrary_int(&abs_num);
+    printf("/");
+    print_arbitrary_int(&abs_den);
 }
 
 void free_fraction(Fraction *frac) {
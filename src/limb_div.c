@@ -0,0 +1,305 @@
+/**
+ * @file limb_div.c
+ * @brief Division algorithms on limb vectors
+ *
+ * Implements schoolbook long division (Knuth, TAOCP vol. 2, 4.3.1,
+ * algorithm D), Burnikel-Ziegler recursive division and division by a
+ * Newton-iteration reciprocal. limbs_divrem normalizes the divisor once
+ * and then picks the algorithm per 2n-by-n block by divisor size.
+ *
+ * The internal routines share one convention: they divide u (un limbs)
+ * in place by a normalized divisor v (vn limbs), write the low un-vn
+ * quotient limbs to q, return the top quotient limb (0 or 1) and leave
+ * the remainder in u[0..vn).
+ */
+
+#include "limb_ops.h"
+#include <stdlib.h>
+#include <string.h>
+
+static limb_t div_block(limb_t *q, limb_t *u, size_t k, const limb_t *v, size_t vn);
+
+/**
+ * @brief Product of two limb vectors in either size order
+ */
+static void mul_any(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    if(an >= bn) {
+        limbs_mul(r, a, an, b, bn);
+    } else {
+        limbs_mul(r, b, bn, a, an);
+    }
+}
+
+/**
+ * @brief Compares a (an limbs) with b (bn limbs) of any lengths
+ */
+static int cmp_any(const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    an = limbs_normalized_size(a, an);
+    bn = limbs_normalized_size(b, bn);
+    if(an != bn) {
+        return an > bn ? 1 : -1;
+    }
+    return limbs_cmp(a, b, an);
+}
+
+/**
+ * @brief Schoolbook division, one quotient limb per step
+ */
+static limb_t div_schoolbook(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    const dlimb_t base = limb_join(1, 0);
+    limb_t qh = limbs_cmp(u + un - vn, v, vn) >= 0;
+    if(qh) {
+        limbs_sub_n(u + un - vn, u + un - vn, v, vn);
+    }
+
+    if(vn == 1) {
+        limb_t rem = u[un - 1];
+        for(size_t j = un - 1; j-- > 0;) {
+            dlimb_t cur = limb_join(rem, u[j]);
+            q[j] = (limb_t)(cur / v[0]);
+            rem = (limb_t)(cur % v[0]);
+        }
+        u[0] = rem;
+        return qh;
+    }
+
+    limb_t v1 = v[vn - 1];
+    limb_t v2 = v[vn - 2];
+    for(size_t j = un - vn; j-- > 0;) {
+        // Estimate from the top two limbs; too large by at most two
+        dlimb_t num = limb_join(u[j + vn], u[j + vn - 1]);
+        dlimb_t qhat = num / v1;
+        dlimb_t rhat = num % v1;
+        while(qhat >= base || qhat * v2 > limb_join((limb_t)rhat, u[j + vn - 2])) {
+            qhat--;
+            rhat += v1;
+            if(rhat >= base) {
+                break;
+            }
+        }
+
+        // Now qhat is exact or one too large; the latter shows as a borrow
+        limb_t borrow = limbs_submul_1(u + j, v, vn, (limb_t)qhat);
+        if(u[j + vn] < borrow) {
+            qhat--;
+            limbs_add_n(u + j, u + j, v, vn);
+        }
+        // The partial remainder is below v, so its top limb is zero
+        u[j + vn] = 0;
+        q[j] = (limb_t)qhat;
+    }
+    return qh;
+}
+
+/**
+ * @brief Approximates floor(B^2n / v) for a normalized n-limb v
+ * @param r Output with n+1 limbs, within a few units of the exact value
+ *
+ * Newton's iteration x' = x + x(B^2n - v*x) / B^2n, started from the
+ * reciprocal of the top half of v, doubles the number of correct limbs
+ * per level.
+ */
+static void reciprocal(limb_t *r, const limb_t *v, size_t n) {
+    if(n < DIV_BZ_THRESHOLD) {
+        limb_t *num = limbs_alloc(2 * n + 1);
+        memset(num, 0, 2 * n * sizeof(limb_t));
+        num[2 * n] = 1;
+        if(n == 1) {
+            limbs_divrem_1(num, num, 3, v[0]);
+            memcpy(r, num, 2 * sizeof(limb_t));
+        } else {
+            div_schoolbook(r, num, 2 * n + 1, v, n);
+        }
+        free(num);
+        return;
+    }
+
+    // rh ~ B^2h / vh for the top h limbs, so x = rh * B^(n-h)
+    size_t h = (n + 1) / 2 + 1;
+    limb_t *rh = limbs_alloc(h + 1);
+    reciprocal(rh, v + n - h, h);
+
+    // e = B^(n+h) - v*rh; since v*x = v*rh * B^(n-h), the correction
+    // x*e*B^(n-h) / B^2n reduces to rh*e / B^2h
+    size_t vrn = n + h + 1;
+    limb_t *vr = limbs_alloc(3 * vrn + h + 1);
+    limb_t *e = vr + vrn;
+    limb_t *t = e + vrn;
+    limbs_mul(vr, v, n, rh, h + 1);
+    bool negative = vr[n + h] != 0;
+    if(negative) {
+        memcpy(e, vr, vrn * sizeof(limb_t));
+        e[n + h]--;
+    } else {
+        memset(e, 0, (n + h) * sizeof(limb_t));
+        limbs_sub_n(e, e, vr, n + h);
+        e[n + h] = 0;
+    }
+    size_t en = limbs_normalized_size(e, vrn);
+
+    // Only the top of rh*e survives the shift, so drop the low h-2
+    // limbs of e; the truncation error stays below one unit
+    size_t drop = h - 2;
+    memset(r, 0, (n - h) * sizeof(limb_t));
+    memcpy(r + n - h, rh, (h + 1) * sizeof(limb_t));
+    if(en > drop) {
+        mul_any(t, rh, h + 1, e + drop, en - drop);
+        size_t tn = limbs_normalized_size(t, h + 1 + en - drop);
+        if(tn > h + 2) {
+            size_t cn = tn - (h + 2);
+            if(cn > n + 1) {
+                cn = n + 1;
+            }
+            if(negative) {
+                limbs_sub(r, r, n + 1, t + h + 2, cn);
+            } else {
+                limbs_add(r, r, n + 1, t + h + 2, cn);
+            }
+        }
+    }
+
+    free(vr);
+    free(rh);
+}
+
+/**
+ * @brief Division by multiplying with a Newton reciprocal of the divisor
+ *
+ * The quotient estimate uses only the top limbs of u and v and is off
+ * by at most a few units; one full product q*v then fixes it exactly.
+ */
+static limb_t div_newton(limb_t *q, limb_t *u, size_t un, const limb_t *v, size_t vn) {
+    limb_t qh = limbs_cmp(u + un - vn, v, vn) >= 0;
+    if(qh) {
+        limbs_sub_n(u + un - vn, u + un - vn, v, vn);
+    }
+
+    // Q = u/v < B^qn needs only the top l = qn+1 divisor limbs, and the
+    // dividend down to two guard limbs below those
+    size_t qn = un - vn;
+    size_t l = (vn < qn + 1) ? vn : qn + 1;
+    size_t shift = vn - 2;
+    limb_t *r = limbs_alloc(l + 1);
+    reciprocal(r, v + vn - l, l);
+
+    // est = floor(u / B^shift * r / B^(l+2)), qn+1 limbs
+    size_t top = un - shift;
+    size_t pn = top + l + 1;
+    limb_t *p = limbs_alloc(pn + un + 1);
+    limb_t *qv = p + pn;
+    limb_t *est = p + l + 2;
+    mul_any(p, u + shift, top, r, l + 1);
+    free(r);
+
+    // Fix the estimate against the exact product est*v
+    size_t en = limbs_normalized_size(est, qn + 1);
+    memset(qv, 0, (un + 1) * sizeof(limb_t));
+    if(en > 0) {
+        mul_any(qv, est, en, v, vn);
+    }
+    while(cmp_any(qv, un + 1, u, un) > 0) {
+        limbs_sub_1(est, est, qn + 1, 1);
+        limbs_sub(qv, qv, un + 1, v, vn);
+    }
+    limbs_sub_n(u, u, qv, un);
+    while(cmp_any(u, un, v, vn) >= 0) {
+        limbs_add_1(est, est, qn + 1, 1);
+        limbs_sub(u, u, un, v, vn);
+    }
+
+    memcpy(q, est, qn * sizeof(limb_t));
+    free(p);
+    return qh;
+}
+
+/**
+ * @brief Divides 2n limbs by n limbs recursively (Burnikel-Ziegler)
+ *
+ * Splits the quotient into a high and a low half, each computed as a
+ * 3-by-2 block division whose top part recurses on half the divisor.
+ */
+static limb_t div_recursive(limb_t *q, limb_t *u, const limb_t *v, size_t n) {
+    if(n < DIV_BZ_THRESHOLD) {
+        return div_schoolbook(q, u, 2 * n, v, n);
+    }
+    if(n >= DIV_NEWTON_THRESHOLD) {
+        return div_newton(q, u, 2 * n, v, n);
+    }
+
+    size_t lo = n / 2;
+    size_t hi = n - lo;
+    limb_t qh = div_block(q + lo, u + lo, hi, v, n);
+    div_block(q, u, lo, v, n);
+    return qh;
+}
+
+/**
+ * @brief Divides vn+k limbs by vn limbs, producing k quotient limbs
+ *
+ * Divides the top 2k limbs by the top k divisor limbs, then subtracts
+ * the quotient times the remaining divisor limbs. The top-limb estimate
+ * is at most two too large, which the add-back loop corrects.
+ */
+static limb_t div_block(limb_t *q, limb_t *u, size_t k, const limb_t *v, size_t vn) {
+    if(k == vn) {
+        return div_recursive(q, u, v, vn);
+    }
+
+    size_t rest = vn - k;
+    limb_t qh = div_recursive(q, u + rest, v + rest, k);
+
+    limb_t *t = limbs_alloc(vn);
+    mul_any(t, q, k, v, rest);
+    long borrow = (long)limbs_sub_n(u, u, t, vn);
+    if(qh) {
+        borrow += (long)limbs_sub_n(u + k, u + k, v, rest);
+    }
+    while(borrow > 0) {
+        qh -= limbs_sub_1(q, q, k, 1);
+        borrow -= (long)limbs_add_n(u, u, v, vn);
+    }
+    free(t);
+    return qh;
+}
+
+void limbs_divrem(limb_t *q, limb_t *r, const limb_t *a, size_t an, const limb_t *d, size_t dn) {
+    if(dn == 1) {
+        r[0] = limbs_divrem_1(q, a, an, d[0]);
+        return;
+    }
+
+    // Normalize so the divisor's top limb is at least half the radix.
+    // Scaling by floor(B / (top + 1)) works for both limb radices and
+    // never carries out of the divisor.
+    const dlimb_t base = limb_join(1, 0);
+    limb_t top = d[dn - 1];
+    limb_t scale = (top == LIMB_MAX) ? 1 : (limb_t)(base / ((dlimb_t)top + 1));
+
+    size_t un = an + 1;
+    limb_t *u = limbs_alloc(un + dn);
+    limb_t *v = u + un;
+    if(scale == 1) {
+        memcpy(u, a, an * sizeof(limb_t));
+        memcpy(v, d, dn * sizeof(limb_t));
+        u[an] = 0;
+    } else {
+        u[an] = limbs_mul_1(u, a, an, scale);
+        limbs_mul_1(v, d, dn, scale);
+    }
+
+    // The quotient fits in un-dn limbs, so every top limb returned is 0
+    size_t qn = un - dn;
+    if(dn < DIV_BZ_THRESHOLD) {
+        div_schoolbook(q, u, un, v, dn);
+    } else {
+        // Blocks of dn quotient limbs from the top, the first one partial
+        size_t k = qn % dn ? qn % dn : dn;
+        for(size_t i = qn; i > 0; i -= k, k = dn) {
+            div_block(q + i - k, u + i - k, k, v, dn);
+        }
+    }
+
+    // Undo the normalization on the remainder
+    limbs_divrem_1(r, u, dn, scale);
+    free(u);
+}
@@ -0,0 +1,591 @@
+/**
+ * @file limb_gcd.c
+ * @brief Greatest common divisor of limb vectors
+ *
+ * Implements Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, algorithm
+ * L): single-precision Euclid steps on the leading bits of both
+ * operands build a 2x2 cofactor matrix, which is then applied to the
+ * full operands in one linear pass. Operands that fit in two limbs
+ * finish with binary (Stein) GCD on double-width words.
+ *
+ * From GCD_HGCD_THRESHOLD limbs on, a recursive half-GCD in the style
+ * of Schoenhage and Moeller takes over. It reduces the top half of the
+ * operands to half their size, recursively, and carries the resulting
+ * cofactor matrix over to the full operands with fast multiplication.
+ *
+ * Cofactor matrices M are kept with non-negative entries and satisfy
+ * (a; b) = M (x; y) for the original pair (a, b) and the current pair
+ * (x, y), so det M = +-1 and x = det * (m11 a - m01 b).
+ */
+
+#include "limb_ops.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Signed double-width word for cofactor arithmetic */
+typedef __int128 sdlimb_t;
+
+/** Largest cofactor magnitude a Lehmer step may build */
+#define COFACTOR_MAX ((sdlimb_t)(LIMB_MAX / 2))
+
+/**
+ * @brief 2x2 matrix of non-negative limb vectors with determinant +-1
+ */
+typedef struct {
+    limb_t *e[4];       /**< Entries m00, m01, m10, m11, cap limbs each */
+    limb_t *spare[2];   /**< Scratch entries swapped in by updates */
+    limb_t *mem;        /**< Backing storage for all six vectors */
+    size_t n;           /**< Limbs in use by every entry */
+    size_t cap;         /**< Limbs allocated per entry */
+    int det;            /**< Determinant, +1 or -1 */
+} GcdMatrix;
+
+static void matrix_init(GcdMatrix *m, size_t cap) {
+    m->mem = limbs_alloc(6 * cap);
+    memset(m->mem, 0, 4 * cap * sizeof(limb_t));
+    for(int i = 0; i < 4; i++) {
+        m->e[i] = m->mem + i * cap;
+    }
+    m->spare[0] = m->mem + 4 * cap;
+    m->spare[1] = m->mem + 5 * cap;
+    m->e[0][0] = 1;
+    m->e[3][0] = 1;
+    m->n = 1;
+    m->cap = cap;
+    m->det = 1;
+}
+
+/**
+ * @brief Shrinks m->n past limbs that are zero in every entry
+ */
+static void matrix_normalize(GcdMatrix *m) {
+    while(m->n > 1 && !(m->e[0][m->n - 1] | m->e[1][m->n - 1] |
+                        m->e[2][m->n - 1] | m->e[3][m->n - 1])) {
+        m->n--;
+    }
+}
+
+/**
+ * @brief m = m * (n00 n01; n10 n11) for single-limb entries
+ *
+ * Each new entry is below B^(n+1) because the entries of m and of the
+ * factor are below half a limb or the factor is a quotient step.
+ */
+static void matrix_mul_limbs(GcdMatrix *m, limb_t n00, limb_t n01, limb_t n10, limb_t n11, int det) {
+    size_t n = m->n;
+    for(int row = 0; row < 4; row += 2) {
+        limb_t *x = m->e[row];
+        limb_t *y = m->e[row + 1];
+        limb_t *u = m->spare[0];
+        limb_t *v = m->spare[1];
+        u[n] = limbs_mul_1(u, x, n, n00);
+        u[n] += limbs_addmul_1(u, y, n, n10);
+        v[n] = limbs_mul_1(v, x, n, n01);
+        v[n] += limbs_addmul_1(v, y, n, n11);
+        m->spare[0] = x;
+        m->spare[1] = y;
+        m->e[row] = u;
+        m->e[row + 1] = v;
+    }
+    m->n = n + 1;
+    m->det *= det;
+    matrix_normalize(m);
+}
+
+/**
+ * @brief Product r = a * b of any sizes, writing an + bn limbs
+ */
+static void mul_sized(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t na = limbs_normalized_size(a, an);
+    size_t nb = limbs_normalized_size(b, bn);
+    memset(r, 0, (an + bn) * sizeof(limb_t));
+    if(na == 0 || nb == 0) {
+        return;
+    }
+    if(na >= nb) {
+        limbs_mul(r, a, na, b, nb);
+    } else {
+        limbs_mul(r, b, nb, a, na);
+    }
+}
+
+/**
+ * @brief m = m * (q 1; 1 0), the matrix of one Euclidean step
+ */
+static void matrix_mul_quotient(GcdMatrix *m, const limb_t *q, size_t qn) {
+    if(qn == 1) {
+        matrix_mul_limbs(m, q[0], 1, 1, 0, -1);
+        return;
+    }
+
+    size_t n = m->n;
+    for(int row = 0; row < 4; row += 2) {
+        limb_t *x = m->e[row];
+        limb_t *y = m->e[row + 1];
+        limb_t *u = m->spare[0];
+        mul_sized(u, x, n, q, qn);
+        u[n + qn] = limbs_add(u, u, n + qn, y, n);
+        m->spare[0] = y;
+        m->e[row] = u;
+        m->e[row + 1] = x;
+        memset(x + n, 0, (qn + 1) * sizeof(limb_t));
+    }
+    m->n = n + qn + 1;
+    m->det = -m->det;
+    matrix_normalize(m);
+}
+
+/**
+ * @brief m = m * (0 1; 1 0), for swapping the current pair
+ */
+static void matrix_swap_columns(GcdMatrix *m) {
+    limb_t *t = m->e[0];
+    m->e[0] = m->e[1];
+    m->e[1] = t;
+    t = m->e[2];
+    m->e[2] = m->e[3];
+    m->e[3] = t;
+    m->det = -m->det;
+}
+
+/**
+ * @brief m = m * k for a full cofactor matrix k
+ */
+static void matrix_mul(GcdMatrix *m, const GcdMatrix *k) {
+    size_t pn = m->n + k->n;
+    size_t cap = m->cap > pn + 2 ? m->cap : pn + 2;
+    limb_t *mem = limbs_alloc(6 * cap + pn);
+    limb_t *t = mem + 6 * cap;
+    memset(mem, 0, 4 * cap * sizeof(limb_t));
+
+    limb_t *e[4];
+    for(int i = 0; i < 4; i++) {
+        e[i] = mem + i * cap;
+    }
+    for(int row = 0; row < 4; row += 2) {
+        for(int col = 0; col < 2; col++) {
+            limb_t *r = e[row + col];
+            mul_sized(r, m->e[row], m->n, k->e[col], k->n);
+            mul_sized(t, m->e[row + 1], m->n, k->e[2 + col], k->n);
+            r[pn] = limbs_add_n(r, r, t, pn);
+        }
+    }
+
+    free(m->mem);
+    m->mem = mem;
+    for(int i = 0; i < 4; i++) {
+        m->e[i] = e[i];
+    }
+    m->spare[0] = mem + 4 * cap;
+    m->spare[1] = mem + 5 * cap;
+    m->n = pn + 1;
+    m->cap = cap;
+    m->det *= k->det;
+    matrix_normalize(m);
+}
+
+/**
+ * @brief Binary GCD of two double-width words
+ */
+static dlimb_t gcd_binary(dlimb_t a, dlimb_t b) {
+    if(a == 0) {
+        return b;
+    }
+    if(b == 0) {
+        return a;
+    }
+
+    int shift = 0;
+    while(((a | b) & 1) == 0) {
+        a >>= 1;
+        b >>= 1;
+        shift++;
+    }
+    while((a & 1) == 0) {
+        a >>= 1;
+    }
+    do {
+        while((b & 1) == 0) {
+            b >>= 1;
+        }
+        if(a > b) {
+            dlimb_t t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    } while(b != 0);
+    return a << shift;
+}
+
+/**
+ * @brief Leading bits of a, aligned to the top of an n-limb a
+ *
+ * Returns floor(a / D) for a divisor D that depends only on n and the
+ * top limb of the larger operand, so the same call on b gives floor(b / D).
+ * The result stays below 2^126 to leave headroom for the cofactors.
+ */
+static dlimb_t leading_bits(const limb_t *a, size_t an, size_t n, int shift) {
+    limb_t hi = an >= n ? a[n - 1] : 0;
+    limb_t mid = an >= n - 1 ? a[n - 2] : 0;
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    (void)shift;
+    return limb_join(hi, mid);
+#else
+    limb_t lo = (n >= 3 && an >= n - 2) ? a[n - 3] : 0;
+    dlimb_t top = limb_join(hi, mid);
+    if(shift > 0) {
+        top = (top << shift) | (lo >> (LIMB_BITS - shift));
+    }
+    return top >> 2;
+#endif
+}
+
+/**
+ * @brief Runs Euclid on the leading bits of a and b (a >= b, an >= 2 limbs)
+ * @param m Output cofactors {A, B, C, D}
+ * @return false if not even one quotient could be certified
+ *
+ * Only quotients that are the same for both ends of the interval the
+ * true ratio lies in are taken, so (A*a + B*b, C*a + D*b) is a pair of
+ * consecutive remainders of the full Euclidean sequence.
+ */
+static bool lehmer_matrix(const limb_t *a, size_t an, const limb_t *b, size_t bn, sdlimb_t m[4]) {
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    int shift = 0;
+#else
+    int shift = __builtin_clzll(a[an - 1]);
+#endif
+    sdlimb_t x = (sdlimb_t)leading_bits(a, an, an, shift);
+    sdlimb_t y = (sdlimb_t)leading_bits(b, bn, an, shift);
+    sdlimb_t A = 1, B = 0, C = 0, D = 1;
+
+    while(y + C != 0 && y + D != 0) {
+        sdlimb_t q = (x + A) / (y + C);
+        if(q != (x + B) / (y + D) || q > COFACTOR_MAX) {
+            break;
+        }
+        sdlimb_t nc = A - q * C;
+        sdlimb_t nd = B - q * D;
+        if(nc > COFACTOR_MAX || -nc > COFACTOR_MAX || nd > COFACTOR_MAX || -nd > COFACTOR_MAX) {
+            break;
+        }
+        A = C;
+        B = D;
+        C = nc;
+        D = nd;
+        sdlimb_t t = x - q * y;
+        x = y;
+        y = t;
+    }
+
+    m[0] = A;
+    m[1] = B;
+    m[2] = C;
+    m[3] = D;
+    return B != 0;
+}
+
+/**
+ * @brief Records a Lehmer matrix (x' = Ax + By, y' = Cx + Dy) in m
+ *
+ * The inverse step is (x; y) = (|D| |B|; |C| |A|) (x'; y').
+ */
+static void matrix_mul_lehmer(GcdMatrix *m, const sdlimb_t c[4]) {
+    sdlimb_t a = c[0] < 0 ? -c[0] : c[0];
+    sdlimb_t b = c[1] < 0 ? -c[1] : c[1];
+    sdlimb_t k = c[2] < 0 ? -c[2] : c[2];
+    sdlimb_t d = c[3] < 0 ? -c[3] : c[3];
+    int det = c[0] * c[3] - c[1] * c[2] > 0 ? 1 : -1;
+    matrix_mul_limbs(m, (limb_t)d, (limb_t)b, (limb_t)k, (limb_t)a, det);
+}
+
+/**
+ * @brief Sets r = u*a + v*b for cofactors of opposite sign (or zero)
+ * @return Size of r, at most n + 1 limbs
+ *
+ * The caller guarantees the result is non-negative.
+ */
+static size_t combine(limb_t *r, const limb_t *a, const limb_t *b, size_t n, sdlimb_t u, sdlimb_t v) {
+    if(u < 0) {
+        const limb_t *t = a;
+        a = b;
+        b = t;
+        sdlimb_t s = u;
+        u = v;
+        v = s;
+    }
+    r[n] = limbs_mul_1(r, a, n, (limb_t)u);
+    if(v >= 0) {
+        r[n] += limbs_addmul_1(r, b, n, (limb_t)v);
+    } else {
+        r[n] -= limbs_submul_1(r, b, n, (limb_t)-v);
+    }
+    return limbs_normalized_size(r, n + 1);
+}
+
+/**
+ * @brief One reduction step of a half-GCD on n-limb buffers a >= b
+ * @param s The step is refused if it would leave b with s limbs or fewer
+ * @return false if no step was taken
+ *
+ * Tries a Lehmer matrix first and falls back to a single, exact
+ * division. Both buffers stay zero-padded to n limbs.
+ */
+static bool hgcd_step(limb_t *a, limb_t *b, size_t n, size_t s, GcdMatrix *m) {
+    size_t an = limbs_normalized_size(a, n);
+    size_t bn = limbs_normalized_size(b, n);
+    limb_t *work = limbs_alloc(2 * an + 3);
+    limb_t *t = work;
+    limb_t *u = t + an + 1;
+    bool progress = false;
+
+    sdlimb_t c[4];
+    if(an > 2 && bn + 1 >= an && lehmer_matrix(a, an, b, bn, c)) {
+        combine(t, a, b, an, c[0], c[1]);
+        if(combine(u, a, b, an, c[2], c[3]) > s) {
+            memcpy(a, t, an * sizeof(limb_t));
+            memcpy(b, u, an * sizeof(limb_t));
+            matrix_mul_lehmer(m, c);
+            progress = true;
+        }
+    }
+
+    if(!progress) {
+        // t holds the quotient, u the remainder
+        limbs_divrem(t, u, a, an, b, bn);
+        if(limbs_normalized_size(u, bn) > s) {
+            matrix_mul_quotient(m, t, limbs_normalized_size(t, an - bn + 1));
+            memcpy(a, b, bn * sizeof(limb_t));
+            memset(a + bn, 0, (n - bn) * sizeof(limb_t));
+            memcpy(b, u, bn * sizeof(limb_t));
+            progress = true;
+        }
+    }
+
+    free(work);
+    return progress;
+}
+
+/**
+ * @brief Carries a matrix from the top part of (a, b) over to the whole
+ * @param p Number of low limbs below the top part
+ * @return false if the matrix does not apply, leaving a and b undefined
+ *
+ * The top parts a1, b1 (from limb p on) have been reduced to x1, y1 by
+ * k. The full pair then reduces to x = x1*B^p + det*(k11 a0 - k01 b0)
+ * and y = y1*B^p + det*(k00 b0 - k10 a0), which must satisfy x > y >= 0.
+ */
+static bool hgcd_adjust(limb_t *a, limb_t *b, size_t n, size_t p, const GcdMatrix *k) {
+    size_t dn = p + k->n;
+    limb_t *work = limbs_alloc(2 * p + 3 * dn);
+    limb_t *a0 = work;
+    limb_t *b0 = a0 + p;
+    limb_t *t = b0 + p;
+    limb_t *u = t + dn;
+    limb_t *d = u + dn;
+    memcpy(a0, a, p * sizeof(limb_t));
+    memcpy(b0, b, p * sizeof(limb_t));
+    memset(a, 0, p * sizeof(limb_t));
+    memset(b, 0, p * sizeof(limb_t));
+
+    bool ok = true;
+    limb_t *targets[2] = {a, b};
+    for(int i = 0; i < 2 && ok; i++) {
+        // i = 0: k11 a0 - k01 b0, i = 1: k00 b0 - k10 a0
+        mul_sized(t, i ? k->e[0] : k->e[3], k->n, i ? b0 : a0, p);
+        mul_sized(u, i ? k->e[2] : k->e[1], k->n, i ? a0 : b0, p);
+        int sign = limbs_cmp(t, u, dn);
+        if(sign >= 0) {
+            limbs_sub_n(d, t, u, dn);
+        } else {
+            limbs_sub_n(d, u, t, dn);
+        }
+        size_t size = limbs_normalized_size(d, dn);
+        if(size > n) {
+            ok = false;
+        } else if(sign * k->det >= 0) {
+            ok = limbs_add(targets[i], targets[i], n, d, size) == 0;
+        } else {
+            ok = limbs_sub(targets[i], targets[i], n, d, size) == 0;
+        }
+    }
+    free(work);
+    return ok && limbs_cmp(a, b, n) > 0;
+}
+
+static size_t hgcd(limb_t *a, limb_t *b, size_t n, GcdMatrix *m);
+
+/**
+ * @brief Reduces the top n - p limbs recursively and applies the result
+ * @return false if the pair was left unchanged
+ */
+static bool hgcd_reduce(limb_t *a, limb_t *b, size_t n, size_t p, GcdMatrix *m) {
+    limb_t *backup = limbs_alloc(2 * n);
+    memcpy(backup, a, n * sizeof(limb_t));
+    memcpy(backup + n, b, n * sizeof(limb_t));
+
+    GcdMatrix k;
+    matrix_init(&k, n - p + 4);
+    bool reduced = hgcd(a + p, b + p, n - p, &k) > 0;
+    if(reduced && hgcd_adjust(a, b, n, p, &k)) {
+        matrix_mul(m, &k);
+    } else {
+        memcpy(a, backup, n * sizeof(limb_t));
+        memcpy(b, backup + n, n * sizeof(limb_t));
+        reduced = false;
+    }
+    free(k.mem);
+    free(backup);
+    return reduced;
+}
+
+/**
+ * @brief Half-GCD: reduces n-limb buffers a >= b to about n/2 limbs
+ * @param m Identity on entry, the reduction matrix on return
+ * @return Size of the reduced a, or 0 if no step was possible
+ *
+ * Stops at the last pair of the Euclidean sequence with both values
+ * above s = n/2 + 1 limbs. Above GCD_HGCD_THRESHOLD the top halves are
+ * reduced recursively, twice, before single steps finish the job.
+ */
+static size_t hgcd(limb_t *a, limb_t *b, size_t n, GcdMatrix *m) {
+    size_t s = n / 2 + 1;
+    if(limbs_normalized_size(b, n) <= s) {
+        return 0;
+    }
+
+    bool progress = false;
+    if(n >= GCD_HGCD_THRESHOLD) {
+        progress = hgcd_reduce(a, b, n, n / 2, m);
+
+        if(limbs_normalized_size(b, n) > s && hgcd_step(a, b, n, s, m)) {
+            progress = true;
+            size_t an = limbs_normalized_size(a, n);
+            size_t p = 2 * s - an + 1;
+            if(p + 2 < an && limbs_normalized_size(b, n) > s) {
+                hgcd_reduce(a, b, an, p, m);
+            }
+        }
+    }
+
+    while(limbs_normalized_size(b, n) > s && hgcd_step(a, b, n, s, m)) {
+        progress = true;
+    }
+    return progress ? limbs_normalized_size(a, n) : 0;
+}
+
+/**
+ * @brief Reduces (a, b) to (gcd, 0), optionally tracking the cofactors
+ * @param g Output for the GCD, min(an, bn) limbs
+ * @param m Cofactor matrix to update, or NULL for the GCD alone
+ * @return Number of limbs in g
+ */
+static size_t gcd_reduce(limb_t *g, const limb_t *a, size_t an, const limb_t *b, size_t bn, GcdMatrix *m) {
+    size_t cap = (an > bn ? an : bn) + 1;
+    limb_t *work = limbs_alloc(4 * cap);
+    limb_t *x = work;
+    limb_t *y = x + cap;
+    limb_t *t = y + cap;
+    limb_t *s = t + cap;
+    memcpy(x, a, an * sizeof(limb_t));
+    memcpy(y, b, bn * sizeof(limb_t));
+    size_t xn = an;
+    size_t yn = bn;
+
+    for(;;) {
+        // Keep x >= y
+        if(xn < yn || (xn == yn && limbs_cmp(x, y, xn) < 0)) {
+            limb_t *p = x;
+            x = y;
+            y = p;
+            size_t pn = xn;
+            xn = yn;
+            yn = pn;
+            if(m) {
+                matrix_swap_columns(m);
+            }
+        }
+        if(yn == 0 || (!m && xn <= 2)) {
+            break;
+        }
+
+        sdlimb_t c[4];
+        if(yn >= GCD_HGCD_THRESHOLD && xn == yn) {
+            // Half-GCD on the top half, carried over to the whole pair
+            GcdMatrix k;
+            matrix_init(&k, xn + 4);
+            bool reduced = hgcd_reduce(x, y, xn, xn / 2, &k);
+            if(reduced && m) {
+                matrix_mul(m, &k);
+            }
+            free(k.mem);
+            if(reduced) {
+                xn = limbs_normalized_size(x, xn);
+                yn = limbs_normalized_size(y, yn);
+                continue;
+            }
+        } else if(xn > 2 && yn + 1 >= xn && lehmer_matrix(x, xn, y, yn, c)) {
+            // The new pair is computed over xn limbs with y zero-extended
+            memset(y + yn, 0, (xn - yn) * sizeof(limb_t));
+            size_t tn = combine(t, x, y, xn, c[0], c[1]);
+            size_t sn = combine(s, x, y, xn, c[2], c[3]);
+            if(m) {
+                matrix_mul_lehmer(m, c);
+            }
+            limb_t *p = x;
+            x = t;
+            t = p;
+            p = y;
+            y = s;
+            s = p;
+            xn = tn;
+            yn = sn;
+            continue;
+        }
+
+        // Quotient too large for the leading bits: one full division
+        limb_t *q = limbs_alloc(xn - yn + 1);
+        limbs_divrem(q, t, x, xn, y, yn);
+        if(m) {
+            matrix_mul_quotient(m, q, limbs_normalized_size(q, xn - yn + 1));
+        }
+        free(q);
+        limb_t *p = x;
+        x = y;
+        y = t;
+        t = p;
+        xn = yn;
+        yn = limbs_normalized_size(y, yn);
+    }
+
+    if(yn != 0) {
+        // Both operands fit in two limbs
+        dlimb_t u = xn > 1 ? limb_join(x[1], x[0]) : x[0];
+        dlimb_t v = yn > 1 ? limb_join(y[1], y[0]) : y[0];
+        x[1] = limb_split(gcd_binary(u, v), &x[0]);
+        xn = limbs_normalized_size(x, 2);
+    }
+    memcpy(g, x, xn * sizeof(limb_t));
+    free(work);
+    return xn;
+}
+
+size_t limbs_gcd(limb_t *g, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    return gcd_reduce(g, a, an, b, bn, NULL);
+}
+
+size_t limbs_gcdext(limb_t *g, limb_t *s, size_t *sn, bool *s_negative,
+                    const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    GcdMatrix m;
+    matrix_init(&m, (an > bn ? an : bn) + 4);
+    size_t gn = gcd_reduce(g, a, an, b, bn, &m);
+
+    // (a; b) = M (g; 0) gives g = det * (m11 a - m01 b)
+    *sn = limbs_normalized_size(m.e[3], m.n);
+    memcpy(s, m.e[3], *sn * sizeof(limb_t));
+    *s_negative = m.det < 0 && *sn > 0;
+
+    free(m.mem);
+    return gn;
+}
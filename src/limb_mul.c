@@ -0,0 +1,617 @@
+/**
+ * @file limb_mul.c
+ * @brief Multiplication algorithms on limb vectors
+ *
+ * Implements schoolbook, Karatsuba, Toom-3 and Toom-4 multiplication,
+ * plus squaring variants of each that exploit the symmetry of a*a.
+ * limbs_mul and limbs_sqr pick the algorithm by operand size and
+ * allocate all scratch space once, up front, so the recursion itself
+ * never touches the allocator.
+ */
+
+#include "limb_ops.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Scratch limbs needed by mul_recursive for an operand of n limbs.
+ * A Karatsuba level uses about 2n limbs and recurses on n/2, Toom-3
+ * about 14n/3 and recurses on n/3, Toom-4 about 22n/4 and recurses on
+ * n/4; each of these sums to at most 8n plus a small term per level
+ * for the rounding.
+ */
+#define MUL_SCRATCH_SIZE(n) (8 * (n) + 64 * LIMB_BITS)
+
+void limbs_mul_basecase(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    r[an] = limbs_mul_1(r, a, an, b[0]);
+    for(size_t j = 1; j < bn; j++) {
+        r[an + j] = limbs_addmul_1(r + j, a, an, b[j]);
+    }
+}
+
+/**
+ * @brief Computes d = |x - y| for xn >= yn
+ * @param d Result (xn limbs)
+ * @return true if x < y (the difference is negative)
+ */
+static bool abs_diff(limb_t *d, const limb_t *x, size_t xn, const limb_t *y, size_t yn) {
+    bool x_smaller = limbs_normalized_size(x + yn, xn - yn) == 0 && limbs_cmp(x, y, yn) < 0;
+    if(x_smaller) {
+        limbs_sub_n(d, y, x, yn);
+        memset(d + yn, 0, (xn - yn) * sizeof(limb_t));
+    } else {
+        limbs_sub(d, x, xn, y, yn);
+    }
+    return x_smaller;
+}
+
+static void mul_recursive(limb_t *r, const limb_t *a, size_t an,
+                          const limb_t *b, size_t bn, limb_t *scratch);
+
+/**
+ * @brief Multiplies operands of very different length (bn <= ceil(an/2))
+ *
+ * Cuts a into bn-limb pieces so every partial product is balanced and
+ * can itself use Karatsuba.
+ */
+static void mul_unbalanced(limb_t *r, const limb_t *a, size_t an,
+                           const limb_t *b, size_t bn, limb_t *scratch) {
+    limb_t *tmp = scratch;
+    scratch += 2 * bn;
+
+    // First piece goes straight into r
+    mul_recursive(r, a, bn, b, bn, scratch);
+
+    for(size_t i = bn; i < an; i += bn) {
+        size_t piece = (an - i < bn) ? an - i : bn;
+        mul_recursive(tmp, b, bn, a + i, piece, scratch);
+
+        // r[i..i+bn) already holds the top half of the previous piece
+        limb_t carry = limbs_add_n(r + i, r + i, tmp, bn);
+        memcpy(r + i + bn, tmp + bn, piece * sizeof(limb_t));
+        limbs_add_1(r + i + bn, r + i + bn, piece, carry);
+    }
+}
+
+/**
+ * @brief Karatsuba multiplication for ceil(an/2) < bn <= an
+ *
+ * With a = a1*B^h + a0 and b = b1*B^h + b0 the middle term is
+ * a0*b1 + a1*b0 = z0 + z2 - (a0 - a1)(b0 - b1); the subtractive form
+ * keeps both factors at h limbs with no carry limb.
+ */
+static void mul_karatsuba(limb_t *r, const limb_t *a, size_t an,
+                          const limb_t *b, size_t bn, limb_t *scratch) {
+    size_t h = an - an / 2;
+    size_t n1 = an - h;
+    size_t m1 = bn - h;
+
+    limb_t *da = scratch;
+    limb_t *db = scratch + h;
+    limb_t *prod = scratch + 2 * h;
+    limb_t *next = scratch + 4 * h;
+
+    // prod = |a0 - a1| * |b0 - b1|, sign tracked separately
+    bool negative = abs_diff(da, a, h, a + h, n1);
+    negative ^= abs_diff(db, b, h, b + h, m1);
+    mul_recursive(prod, da, h, db, h, next);
+
+    // r = z2*B^2h + z0
+    mul_recursive(r, a, h, b, h, next);
+    mul_recursive(r + 2 * h, a + h, n1, b + h, m1, next);
+
+    // t = z0 + z2 -/+ prod in the (now free) da/db area
+    limb_t *t = scratch;
+    long carry = (long)limbs_add(t, r, 2 * h, r + 2 * h, n1 + m1);
+    if(negative) {
+        carry += (long)limbs_add_n(t, t, prod, 2 * h);
+    } else {
+        carry -= (long)limbs_sub_n(t, t, prod, 2 * h);
+    }
+
+    // r += t * B^h; the middle term is never negative, so carry >= 0
+    size_t rn = an + bn;
+    limbs_add(r + h, r + h, rn - h, t, 2 * h);
+    if(carry && rn > 3 * h) {
+        limbs_add_1(r + 3 * h, r + 3 * h, rn - 3 * h, (limb_t)carry);
+    }
+}
+
+/**
+ * @brief Copies src into dst and zero-fills dst up to dn limbs
+ */
+static void copy_extend(limb_t *dst, size_t dn, const limb_t *src, size_t sn) {
+    memcpy(dst, src, sn * sizeof(limb_t));
+    memset(dst + sn, 0, (dn - sn) * sizeof(limb_t));
+}
+
+/**
+ * @brief Sets dst (dn limbs) to src * m, where sn < dn
+ */
+static void scaled_copy(limb_t *dst, size_t dn, const limb_t *src, size_t sn, limb_t m) {
+    dst[sn] = limbs_mul_1(dst, src, sn, m);
+    memset(dst + sn + 1, 0, (dn - sn - 1) * sizeof(limb_t));
+}
+
+/**
+ * @brief Sets p = e + o and m = |e - o| for n-limb values
+ * @return true if e - o is negative
+ */
+static bool eval_pm(limb_t *p, limb_t *m, const limb_t *e, const limb_t *o, size_t n) {
+    limbs_add_n(p, e, o, n);
+    return abs_diff(m, e, n, o, n);
+}
+
+/**
+ * @brief Splits w+ and w- = +/-|w-| into their even and odd halves
+ * @param even Output for (w+ + w-), n limbs
+ * @param plus w+, n limbs
+ * @param minus |w-| on input, (w+ - w-) on output
+ * @param minus_negative Sign of w-
+ */
+static void split_even_odd(limb_t *even, const limb_t *plus, limb_t *minus,
+                           bool minus_negative, size_t n) {
+    if(minus_negative) {
+        limbs_sub_n(even, plus, minus, n);
+        limbs_add_n(minus, plus, minus, n);
+    } else {
+        limbs_add_n(even, plus, minus, n);
+        limbs_sub_n(minus, plus, minus, n);
+    }
+}
+
+/**
+ * @brief Adds an interpolated coefficient into r at a limb offset
+ *
+ * The coefficient buffer may be longer than the room left in r; its
+ * excess high limbs are zero.
+ */
+static void add_coefficient(limb_t *r, size_t rn, size_t offset, const limb_t *c, size_t cn) {
+    cn = limbs_normalized_size(c, cn);
+    if(cn > 0) {
+        limbs_add(r + offset, r + offset, rn - offset, c, cn);
+    }
+}
+
+/**
+ * @brief Evaluates a three-piece operand at 1, -1 and 2
+ * @param x Operand with pieces x0, x1 of k limbs and x2 of top limbs
+ * @param v Output: three n-limb values p(1), |p(-1)|, p(2) with n = k+1
+ * @param tmp Two n-limb temporaries
+ * @return true if p(-1) is negative
+ */
+static bool toom3_evaluate(const limb_t *x, size_t k, size_t top, limb_t *v, limb_t *tmp) {
+    size_t n = k + 1;
+
+    // p(+/-1) from the even part x0 + x2 and the odd part x1
+    copy_extend(tmp, n, x, k);
+    limbs_add(tmp, tmp, n, x + 2 * k, top);
+    copy_extend(tmp + n, n, x + k, k);
+    bool negative = eval_pm(v, v + n, tmp, tmp + n, n);
+
+    // p(2) = (2x2 + x1)*2 + x0
+    limb_t *p2 = v + 2 * n;
+    copy_extend(p2, n, x + 2 * k, top);
+    limbs_mul_1(p2, p2, n, 2);
+    limbs_add(p2, p2, n, x + k, k);
+    limbs_mul_1(p2, p2, n, 2);
+    limbs_add(p2, p2, n, x, k);
+    return negative;
+}
+
+/**
+ * @brief Recovers c1..c3 of a Toom-3 product and adds them into r
+ * @param r Product area holding c0 at 0 and c4 (c4n limbs) at 4k,
+ *          zeros in between
+ * @param w1 Value at 1, wm1 magnitude at -1, w2 value at 2 (2k+2 limbs
+ *           each, all overwritten)
+ * @param tmp 2k+2 limbs of scratch
+ */
+static void toom3_interpolate(limb_t *r, size_t rn, size_t k, size_t c4n, limb_t *w1,
+                              limb_t *wm1, bool wm1_negative, limb_t *w2, limb_t *tmp) {
+    size_t len = 2 * (k + 1);
+    const limb_t *c0 = r;
+    const limb_t *c4 = r + 4 * k;
+
+    // tmp = (w1 + wm1)/2 = c0 + c2 + c4, wm1 = (w1 - wm1)/2 = c1 + c3
+    split_even_odd(tmp, w1, wm1, wm1_negative, len);
+    limbs_divexact_1(tmp, tmp, len, 2);
+    limbs_divexact_1(wm1, wm1, len, 2);
+
+    // tmp = c2
+    limbs_sub(tmp, tmp, len, c0, 2 * k);
+    limbs_sub(tmp, tmp, len, c4, c4n);
+
+    // w2 = (w2 - c0 - 4c2 - 16c4)/2 = c1 + 4c3
+    limbs_sub(w2, w2, len, c0, 2 * k);
+    limbs_mul_1(w1, tmp, len, 4);
+    limbs_sub_n(w2, w2, w1, len);
+    scaled_copy(w1, len, c4, c4n, 16);
+    limbs_sub_n(w2, w2, w1, len);
+    limbs_divexact_1(w2, w2, len, 2);
+
+    // w2 = c3, wm1 = c1
+    limbs_sub_n(w2, w2, wm1, len);
+    limbs_divexact_1(w2, w2, len, 3);
+    limbs_sub_n(wm1, wm1, w2, len);
+
+    add_coefficient(r, rn, k, wm1, len);
+    add_coefficient(r, rn, 2 * k, tmp, len);
+    add_coefficient(r, rn, 3 * k, w2, len);
+}
+
+/**
+ * @brief Toom-3 multiplication for 2*ceil(an/3) < bn <= an
+ *
+ * Splits both operands into three k-limb pieces, evaluates at
+ * 0, 1, -1, 2 and infinity, multiplies the five values recursively and
+ * interpolates the five coefficients c0..c4 of the product polynomial.
+ */
+static void mul_toom3(limb_t *r, const limb_t *a, size_t an,
+                      const limb_t *b, size_t bn, limb_t *scratch) {
+    size_t k = (an + 2) / 3;
+    size_t s = an - 2 * k;
+    size_t t = bn - 2 * k;
+    size_t n = k + 1;
+    size_t len = 2 * n;
+    size_t rn = an + bn;
+
+    limb_t *ap1 = scratch;
+    limb_t *am1 = ap1 + n;
+    limb_t *ap2 = am1 + n;
+    limb_t *bp1 = ap2 + n;
+    limb_t *bm1 = bp1 + n;
+    limb_t *bp2 = bm1 + n;
+    limb_t *w1 = bp2 + n;
+    limb_t *wm1 = w1 + len;
+    limb_t *w2 = wm1 + len;
+    limb_t *tmp = w2 + len;
+    limb_t *next = tmp + len;
+
+    // Evaluate a and b at 1, -1 and 2
+    bool am1_negative = toom3_evaluate(a, k, s, ap1, tmp);
+    bool bm1_negative = toom3_evaluate(b, k, t, bp1, tmp);
+
+    // Pointwise products; c0 and c4 land directly in r
+    mul_recursive(w1, ap1, n, bp1, n, next);
+    mul_recursive(wm1, am1, n, bm1, n, next);
+    mul_recursive(w2, ap2, n, bp2, n, next);
+    mul_recursive(r, a, k, b, k, next);
+    memset(r + 2 * k, 0, 2 * k * sizeof(limb_t));
+    mul_recursive(r + 4 * k, a + 2 * k, s, b + 2 * k, t, next);
+    size_t c4n = s + t;
+
+    toom3_interpolate(r, rn, k, c4n, w1, wm1, am1_negative != bm1_negative, w2, tmp);
+}
+
+/**
+ * @brief Evaluates a four-piece operand at 1, -1, 2, -2 and 1/2
+ * @param x Operand with pieces x0..x2 of k limbs and x3 of top limbs
+ * @param v Output: five n-limb values p(1), |p(-1)|, p(2), |p(-2)|, 8p(1/2)
+ * @param negative Output signs of p(-1) and p(-2)
+ * @param tmp Two n-limb temporaries
+ */
+static void toom4_evaluate(const limb_t *x, size_t k, size_t top, limb_t *v,
+                           bool negative[2], limb_t *tmp) {
+    size_t n = k + 1;
+    limb_t *even = tmp;
+    limb_t *odd = tmp + n;
+
+    // p(+/-1) from x0 + x2 and x1 + x3
+    copy_extend(even, n, x, k);
+    limbs_add(even, even, n, x + 2 * k, k);
+    copy_extend(odd, n, x + k, k);
+    limbs_add(odd, odd, n, x + 3 * k, top);
+    negative[0] = eval_pm(v, v + n, even, odd, n);
+
+    // p(+/-2) from x0 + 4x2 and 2(x1 + 4x3)
+    scaled_copy(even, n, x + 2 * k, k, 4);
+    limbs_add(even, even, n, x, k);
+    scaled_copy(odd, n, x + 3 * k, top, 4);
+    limbs_add(odd, odd, n, x + k, k);
+    limbs_mul_1(odd, odd, n, 2);
+    negative[1] = eval_pm(v + 2 * n, v + 3 * n, even, odd, n);
+
+    // 8p(1/2) = ((2x0 + x1)*2 + x2)*2 + x3
+    limb_t *half = v + 4 * n;
+    scaled_copy(half, n, x, k, 2);
+    limbs_add(half, half, n, x + k, k);
+    limbs_mul_1(half, half, n, 2);
+    limbs_add(half, half, n, x + 2 * k, k);
+    limbs_mul_1(half, half, n, 2);
+    limbs_add(half, half, n, x + 3 * k, top);
+}
+
+/**
+ * @brief Recovers c1..c5 of a Toom-4 product and adds them into r
+ * @param r Product area holding c0 at 0 and c6 (c6n limbs) at 6k,
+ *          zeros in between
+ * @param w1,wm1,w2,wm2,wh Values at 1, -1, 2, -2 and 1/2 (scaled by
+ *        64), 2k+2 limbs each with magnitudes at the negative points;
+ *        all overwritten
+ * @param t1 2k+2 limbs of scratch
+ */
+static void toom4_interpolate(limb_t *r, size_t rn, size_t k, size_t c6n,
+                              limb_t *w1, limb_t *wm1, limb_t *w2, limb_t *wm2, limb_t *wh,
+                              limb_t *t1, bool wm1_negative, bool wm2_negative) {
+    size_t len = 2 * (k + 1);
+    const limb_t *c0 = r;
+    const limb_t *c6 = r + 6 * k;
+
+    // t1 = c0 + c2 + c4 + c6, wm1 = c1 + c3 + c5
+    split_even_odd(t1, w1, wm1, wm1_negative, len);
+    limbs_divexact_1(t1, t1, len, 2);
+    limbs_divexact_1(wm1, wm1, len, 2);
+
+    // w1 = c0 + 4c2 + 16c4 + 64c6, wm2 = c1 + 4c3 + 16c5
+    split_even_odd(w1, w2, wm2, wm2_negative, len);
+    limbs_divexact_1(w1, w1, len, 2);
+    limbs_divexact_1(wm2, wm2, len, 4);
+
+    // t1 = c2 + c4, w1 = c2 + 4c4
+    limbs_sub(t1, t1, len, c0, 2 * k);
+    limbs_sub(t1, t1, len, c6, c6n);
+    limbs_sub(w1, w1, len, c0, 2 * k);
+    scaled_copy(w2, len, c6, c6n, 64);
+    limbs_sub_n(w1, w1, w2, len);
+    limbs_divexact_1(w1, w1, len, 4);
+
+    // w1 = c4, t1 = c2
+    limbs_sub_n(w1, w1, t1, len);
+    limbs_divexact_1(w1, w1, len, 3);
+    limbs_sub_n(t1, t1, w1, len);
+
+    // wh = (wh - 64c0 - 16c2 - 4c4 - c6)/2 = 16c1 + 4c3 + c5
+    scaled_copy(w2, len, c0, 2 * k, 64);
+    limbs_sub_n(wh, wh, w2, len);
+    limbs_mul_1(w2, t1, len, 16);
+    limbs_sub_n(wh, wh, w2, len);
+    limbs_mul_1(w2, w1, len, 4);
+    limbs_sub_n(wh, wh, w2, len);
+    limbs_sub(wh, wh, len, c6, c6n);
+    limbs_divexact_1(wh, wh, len, 2);
+
+    // wm2 = (wm2 - wm1)/3 = c3 + 5c5, w2 = (16wm1 - wh)/3 = 4c3 + 5c5
+    limbs_sub_n(wm2, wm2, wm1, len);
+    limbs_divexact_1(wm2, wm2, len, 3);
+    limbs_mul_1(w2, wm1, len, 16);
+    limbs_sub_n(w2, w2, wh, len);
+    limbs_divexact_1(w2, w2, len, 3);
+
+    // w2 = c3, wm2 = c5, wm1 = c1
+    limbs_sub_n(w2, w2, wm2, len);
+    limbs_divexact_1(w2, w2, len, 3);
+    limbs_sub_n(wm2, wm2, w2, len);
+    limbs_divexact_1(wm2, wm2, len, 5);
+    limbs_sub_n(wm1, wm1, w2, len);
+    limbs_sub_n(wm1, wm1, wm2, len);
+
+    add_coefficient(r, rn, k, wm1, len);
+    add_coefficient(r, rn, 2 * k, t1, len);
+    add_coefficient(r, rn, 3 * k, w2, len);
+    add_coefficient(r, rn, 4 * k, w1, len);
+    add_coefficient(r, rn, 5 * k, wm2, len);
+}
+
+/**
+ * @brief Toom-4 multiplication for 3*ceil(an/4) < bn <= an
+ *
+ * Splits both operands into four k-limb pieces, evaluates at
+ * 0, 1, -1, 2, -2, 1/2 and infinity, and interpolates the seven
+ * coefficients c0..c6. Every interpolation step is an exact division
+ * by 2, 3, 4 or 5 of a non-negative value.
+ */
+static void mul_toom4(limb_t *r, const limb_t *a, size_t an,
+                      const limb_t *b, size_t bn, limb_t *scratch) {
+    size_t k = (an + 3) / 4;
+    size_t s = an - 3 * k;
+    size_t t = bn - 3 * k;
+    size_t n = k + 1;
+    size_t len = 2 * n;
+    size_t rn = an + bn;
+
+    limb_t *av = scratch;
+    limb_t *bv = av + 5 * n;
+    limb_t *w1 = bv + 5 * n;
+    limb_t *wm1 = w1 + len;
+    limb_t *w2 = wm1 + len;
+    limb_t *wm2 = w2 + len;
+    limb_t *wh = wm2 + len;
+    limb_t *t1 = wh + len;
+    limb_t *next = t1 + len;
+
+    bool a_negative[2];
+    bool b_negative[2];
+    toom4_evaluate(a, k, s, av, a_negative, t1);
+    toom4_evaluate(b, k, t, bv, b_negative, t1);
+
+    // Pointwise products; c0 and c6 land directly in r
+    mul_recursive(w1, av, n, bv, n, next);
+    mul_recursive(wm1, av + n, n, bv + n, n, next);
+    mul_recursive(w2, av + 2 * n, n, bv + 2 * n, n, next);
+    mul_recursive(wm2, av + 3 * n, n, bv + 3 * n, n, next);
+    mul_recursive(wh, av + 4 * n, n, bv + 4 * n, n, next);
+    mul_recursive(r, a, k, b, k, next);
+    memset(r + 2 * k, 0, 4 * k * sizeof(limb_t));
+    mul_recursive(r + 6 * k, a + 3 * k, s, b + 3 * k, t, next);
+    size_t c6n = s + t;
+
+    toom4_interpolate(r, rn, k, c6n, w1, wm1, w2, wm2, wh, t1,
+                      a_negative[0] != b_negative[0], a_negative[1] != b_negative[1]);
+}
+
+/**
+ * @brief Dispatches one multiplication by operand shape (an >= bn >= 1)
+ */
+static void mul_recursive(limb_t *r, const limb_t *a, size_t an,
+                          const limb_t *b, size_t bn, limb_t *scratch) {
+    if(bn < KARATSUBA_THRESHOLD) {
+        limbs_mul_basecase(r, a, an, b, bn);
+    } else if(bn >= NTT_THRESHOLD && an + bn <= NTT_MAX_LIMBS) {
+        limbs_mul_ntt(r, a, an, b, bn);
+    } else if(2 * bn <= an + 1) {
+        mul_unbalanced(r, a, an, b, bn, scratch);
+    } else if(bn >= TOOM4_THRESHOLD && bn > 3 * ((an + 3) / 4)) {
+        mul_toom4(r, a, an, b, bn, scratch);
+    } else if(bn >= TOOM3_THRESHOLD && bn > 2 * ((an + 2) / 3)) {
+        mul_toom3(r, a, an, b, bn, scratch);
+    } else {
+        mul_karatsuba(r, a, an, b, bn, scratch);
+    }
+}
+
+void limbs_sqr_basecase(limb_t *r, const limb_t *a, size_t n) {
+    // Off-diagonal products a[i]*a[j], i < j, each computed once
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if(n > 1) {
+        r[n] = limbs_mul_1(r + 1, a + 1, n - 1, a[0]);
+        for(size_t i = 1; i + 1 < n; i++) {
+            r[n + i] = limbs_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
+    }
+
+    // Double them and add the squares a[i]^2 on the diagonal
+    limbs_add_n(r, r, r, 2 * n);
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t lo;
+        limb_t hi = limb_split((dlimb_t)a[i] * a[i], &lo);
+        carry = limb_split((dlimb_t)r[2 * i] + lo + carry, &r[2 * i]);
+        carry = limb_split((dlimb_t)r[2 * i + 1] + hi + carry, &r[2 * i + 1]);
+    }
+}
+
+static void sqr_recursive(limb_t *r, const limb_t *a, size_t n, limb_t *scratch);
+
+/**
+ * @brief Karatsuba squaring: a^2 = z2*B^2h + (z0 + z2 - (a0 - a1)^2)*B^h + z0
+ *
+ * The middle term is 2*a0*a1 and never negative, so unlike the product
+ * case no sign needs tracking.
+ */
+static void sqr_karatsuba(limb_t *r, const limb_t *a, size_t n, limb_t *scratch) {
+    size_t h = n - n / 2;
+    size_t n1 = n - h;
+
+    limb_t *da = scratch;
+    limb_t *prod = scratch + 2 * h;
+    limb_t *next = scratch + 4 * h;
+
+    abs_diff(da, a, h, a + h, n1);
+    sqr_recursive(prod, da, h, next);
+    sqr_recursive(r, a, h, next);
+    sqr_recursive(r + 2 * h, a + h, n1, next);
+
+    limb_t *t = scratch;
+    limb_t carry = limbs_add(t, r, 2 * h, r + 2 * h, 2 * n1);
+    carry -= limbs_sub_n(t, t, prod, 2 * h);
+
+    size_t rn = 2 * n;
+    limbs_add(r + h, r + h, rn - h, t, 2 * h);
+    if(carry && rn > 3 * h) {
+        limbs_add_1(r + 3 * h, r + 3 * h, rn - 3 * h, carry);
+    }
+}
+
+/**
+ * @brief Toom-3 squaring: five squares of the evaluated values
+ */
+static void sqr_toom3(limb_t *r, const limb_t *a, size_t an, limb_t *scratch) {
+    size_t k = (an + 2) / 3;
+    size_t s = an - 2 * k;
+    size_t n = k + 1;
+    size_t len = 2 * n;
+
+    limb_t *av = scratch;
+    limb_t *w1 = av + 3 * n;
+    limb_t *wm1 = w1 + len;
+    limb_t *w2 = wm1 + len;
+    limb_t *tmp = w2 + len;
+    limb_t *next = tmp + len;
+
+    toom3_evaluate(a, k, s, av, tmp);
+    sqr_recursive(w1, av, n, next);
+    sqr_recursive(wm1, av + n, n, next);
+    sqr_recursive(w2, av + 2 * n, n, next);
+    sqr_recursive(r, a, k, next);
+    memset(r + 2 * k, 0, 2 * k * sizeof(limb_t));
+    sqr_recursive(r + 4 * k, a + 2 * k, s, next);
+
+    toom3_interpolate(r, 2 * an, k, 2 * s, w1, wm1, false, w2, tmp);
+}
+
+/**
+ * @brief Toom-4 squaring: seven squares of the evaluated values
+ */
+static void sqr_toom4(limb_t *r, const limb_t *a, size_t an, limb_t *scratch) {
+    size_t k = (an + 3) / 4;
+    size_t s = an - 3 * k;
+    size_t n = k + 1;
+    size_t len = 2 * n;
+
+    limb_t *av = scratch;
+    limb_t *w1 = av + 5 * n;
+    limb_t *wm1 = w1 + len;
+    limb_t *w2 = wm1 + len;
+    limb_t *wm2 = w2 + len;
+    limb_t *wh = wm2 + len;
+    limb_t *t1 = wh + len;
+    limb_t *next = t1 + len;
+
+    bool negative[2];
+    toom4_evaluate(a, k, s, av, negative, t1);
+    sqr_recursive(w1, av, n, next);
+    sqr_recursive(wm1, av + n, n, next);
+    sqr_recursive(w2, av + 2 * n, n, next);
+    sqr_recursive(wm2, av + 3 * n, n, next);
+    sqr_recursive(wh, av + 4 * n, n, next);
+    sqr_recursive(r, a, k, next);
+    memset(r + 2 * k, 0, 4 * k * sizeof(limb_t));
+    sqr_recursive(r + 6 * k, a + 3 * k, s, next);
+
+    toom4_interpolate(r, 2 * an, k, 2 * s, w1, wm1, w2, wm2, wh, t1, false, false);
+}
+
+/**
+ * @brief Dispatches one squaring by operand size
+ */
+static void sqr_recursive(limb_t *r, const limb_t *a, size_t n, limb_t *scratch) {
+    if(n < SQR_KARATSUBA_THRESHOLD) {
+        limbs_sqr_basecase(r, a, n);
+    } else if(n >= NTT_THRESHOLD && 2 * n <= NTT_MAX_LIMBS) {
+        limbs_mul_ntt(r, a, n, a, n);
+    } else if(n >= SQR_TOOM4_THRESHOLD) {
+        sqr_toom4(r, a, n, scratch);
+    } else if(n >= SQR_TOOM3_THRESHOLD) {
+        sqr_toom3(r, a, n, scratch);
+    } else {
+        sqr_karatsuba(r, a, n, scratch);
+    }
+}
+
+void limbs_sqr(limb_t *r, const limb_t *a, size_t n) {
+    if(n < SQR_KARATSUBA_THRESHOLD) {
+        limbs_sqr_basecase(r, a, n);
+        return;
+    }
+
+    limb_t *scratch = limbs_alloc(MUL_SCRATCH_SIZE(n));
+    sqr_recursive(r, a, n, scratch);
+    free(scratch);
+}
+
+void limbs_mul(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    if(a == b && an == bn) {
+        limbs_sqr(r, a, an);
+        return;
+    }
+    if(bn < KARATSUBA_THRESHOLD) {
+        limbs_mul_basecase(r, a, an, b, bn);
+        return;
+    }
+
+    limb_t *scratch = limbs_alloc(MUL_SCRATCH_SIZE(an));
+    mul_recursive(r, a, an, b, bn, scratch);
+    free(scratch);
+}
@@ -0,0 +1,239 @@
+/**
+ * @file limb_ntt.c
+ * @brief Three-prime number-theoretic transform multiplication
+ *
+ * Each limb is cut into two pieces (32 bits, or nine decimal digits in
+ * ARBITRARY_INT_DECIMAL_LIMBS builds). The piece sequences are
+ * convolved modulo three NTT-friendly primes below 2^30. The exact
+ * convolution is then rebuilt with the Chinese remainder theorem. The
+ * three primes multiply to more than 2^86. That bound covers every
+ * coefficient up to the maximum transform length of 2^23 pieces.
+ */
+
+#include "limb_ops.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NTT_P1 998244353u   // 119 * 2^23 + 1
+#define NTT_P2 167772161u   //   5 * 2^25 + 1
+#define NTT_P3 469762049u   //   7 * 2^26 + 1
+
+/** 3 is a primitive root of all three primes */
+#define NTT_GENERATOR 3u
+
+/** P1^-1 mod P2 and (P1*P2)^-1 mod P3, used by the CRT */
+#define NTT_P1_INV_P2 47450712u
+#define NTT_P12_INV_P3 115990628u
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+#define PIECE_BASE 1000000000u
+#else
+#define PIECE_BASE ((limb_t)1 << 32)
+#endif
+
+/**
+ * @brief Montgomery arithmetic context for one prime (R = 2^32)
+ */
+typedef struct {
+    uint32_t p;         /**< The prime */
+    uint32_t p_neg_inv; /**< -p^-1 mod 2^32 */
+    uint32_t r2;        /**< R^2 mod p */
+} NttPrime;
+
+static NttPrime ntt_prime(uint32_t p) {
+    uint32_t inv = p;   // Correct to 3 bits for odd p, doubled per step
+    for(int i = 0; i < 4; i++) {
+        inv *= 2 - p * inv;
+    }
+    uint64_t r = ((uint64_t)1 << 32) % p;
+    NttPrime ctx = {p, (uint32_t)0 - inv, (uint32_t)(r * r % p)};
+    return ctx;
+}
+
+/**
+ * @brief Returns x * R^-1 mod p for x < p * 2^32
+ */
+static inline uint32_t mont_reduce(uint64_t x, const NttPrime *ctx) {
+    uint32_t m = (uint32_t)x * ctx->p_neg_inv;
+    uint32_t t = (uint32_t)((x + (uint64_t)m * ctx->p) >> 32);
+    return t >= ctx->p ? t - ctx->p : t;
+}
+
+static inline uint32_t mont_mul(uint32_t a, uint32_t b, const NttPrime *ctx) {
+    return mont_reduce((uint64_t)a * b, ctx);
+}
+
+static inline uint32_t mod_add(uint32_t a, uint32_t b, uint32_t p) {
+    uint32_t s = a + b;
+    return s >= p ? s - p : s;
+}
+
+static inline uint32_t mod_sub(uint32_t a, uint32_t b, uint32_t p) {
+    return a >= b ? a - b : a + p - b;
+}
+
+static uint32_t mod_pow(uint32_t base, uint64_t exp, uint32_t p) {
+    uint64_t result = 1;
+    uint64_t b = base % p;
+    while(exp) {
+        if(exp & 1) {
+            result = result * b % p;
+        }
+        b = b * b % p;
+        exp >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+/**
+ * @brief Fills the per-level twiddle tables in Montgomery form
+ * @param roots Output, roots[m + j] = w_2m^j for every level m < n
+ * @param inverse_roots Same for the inverse roots
+ */
+static void ntt_roots(uint32_t *roots, uint32_t *inverse_roots, size_t n, const NttPrime *ctx) {
+    uint32_t p = ctx->p;
+    uint32_t one = mont_reduce((uint64_t)1 * ctx->r2, ctx);
+    for(size_t m = 1; m < n; m <<= 1) {
+        uint32_t w = mod_pow(NTT_GENERATOR, (p - 1) / (2 * m), p);
+        uint32_t w_mont = mont_mul(w, ctx->r2, ctx);
+        uint32_t w_inv_mont = mont_mul(mod_pow(w, p - 2, p), ctx->r2, ctx);
+        roots[m] = one;
+        inverse_roots[m] = one;
+        for(size_t j = 1; j < m; j++) {
+            roots[m + j] = mont_mul(roots[m + j - 1], w_mont, ctx);
+            inverse_roots[m + j] = mont_mul(inverse_roots[m + j - 1], w_inv_mont, ctx);
+        }
+    }
+}
+
+/**
+ * @brief Forward transform (decimation in frequency)
+ *
+ * Natural-order input, bit-reversed output.
+ */
+static void ntt_forward(uint32_t *x, size_t n, const uint32_t *roots, const NttPrime *ctx) {
+    uint32_t p = ctx->p;
+    for(size_t m = n / 2; m >= 1; m >>= 1) {
+        const uint32_t *w = roots + m;
+        for(size_t i = 0; i < n; i += 2 * m) {
+            for(size_t j = 0; j < m; j++) {
+                uint32_t u = x[i + j];
+                uint32_t v = x[i + j + m];
+                x[i + j] = mod_add(u, v, p);
+                x[i + j + m] = mont_mul(mod_sub(u, v, p), w[j], ctx);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Inverse transform without the 1/n scaling (decimation in time)
+ *
+ * Bit-reversed input, natural-order output.
+ */
+static void ntt_inverse(uint32_t *x, size_t n, const uint32_t *inverse_roots, const NttPrime *ctx) {
+    uint32_t p = ctx->p;
+    for(size_t m = 1; m < n; m <<= 1) {
+        const uint32_t *w = inverse_roots + m;
+        for(size_t i = 0; i < n; i += 2 * m) {
+            for(size_t j = 0; j < m; j++) {
+                uint32_t u = x[i + j];
+                uint32_t v = mont_mul(x[i + j + m], w[j], ctx);
+                x[i + j] = mod_add(u, v, p);
+                x[i + j + m] = mod_sub(u, v, p);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes the pieces of a limb vector, reduced and in Montgomery form
+ */
+static void load_pieces(uint32_t *x, size_t n, const limb_t *a, size_t an, const NttPrime *ctx) {
+    for(size_t i = 0; i < an; i++) {
+        limb_t lo = a[i] % PIECE_BASE;
+        limb_t hi = a[i] / PIECE_BASE;
+        // piece * R^2 < 2^32 * p, so one reduction gives piece * R mod p
+        x[2 * i] = mont_reduce(lo * ctx->r2, ctx);
+        x[2 * i + 1] = mont_reduce(hi * ctx->r2, ctx);
+    }
+    memset(x + 2 * an, 0, (n - 2 * an) * sizeof(uint32_t));
+}
+
+/**
+ * @brief Cyclic convolution of the pieces of a and b modulo one prime
+ * @param fa Output residues (n values, natural order, normal form)
+ * @param fb Scratch of n values, unused when squaring
+ * @param tables Scratch of 2n values for the twiddle tables
+ */
+static void convolve(uint32_t *fa, uint32_t *fb, uint32_t *tables, size_t n,
+                     const limb_t *a, size_t an, const limb_t *b, size_t bn, uint32_t p) {
+    NttPrime ctx = ntt_prime(p);
+    uint32_t *roots = tables;
+    uint32_t *inverse_roots = tables + n;
+    ntt_roots(roots, inverse_roots, n, &ctx);
+
+    load_pieces(fa, n, a, an, &ctx);
+    ntt_forward(fa, n, roots, &ctx);
+    if(a == b && an == bn) {
+        for(size_t i = 0; i < n; i++) {
+            fa[i] = mont_mul(fa[i], fa[i], &ctx);
+        }
+    } else {
+        load_pieces(fb, n, b, bn, &ctx);
+        ntt_forward(fb, n, roots, &ctx);
+        for(size_t i = 0; i < n; i++) {
+            fa[i] = mont_mul(fa[i], fb[i], &ctx);
+        }
+    }
+    ntt_inverse(fa, n, inverse_roots, &ctx);
+
+    // Scaling by plain n^-1 also takes the values out of Montgomery form
+    uint32_t n_inv = mod_pow((uint32_t)(n % p), p - 2, p);
+    for(size_t i = 0; i < n; i++) {
+        fa[i] = mont_mul(fa[i], n_inv, &ctx);
+    }
+}
+
+void limbs_mul_ntt(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    size_t pieces = 2 * (an + bn);
+    size_t n = 1;
+    while(n < pieces - 1) {
+        n <<= 1;
+    }
+
+    // Three residue vectors, one operand transform and the twiddle tables
+    uint32_t *work = (uint32_t *)limbs_alloc(3 * n);
+    uint32_t *res1 = work;
+    uint32_t *res2 = res1 + n;
+    uint32_t *res3 = res2 + n;
+    uint32_t *fb = res3 + n;
+    uint32_t *tables = fb + n;
+
+    convolve(res1, fb, tables, n, a, an, b, bn, NTT_P1);
+    convolve(res2, fb, tables, n, a, an, b, bn, NTT_P2);
+    convolve(res3, fb, tables, n, a, an, b, bn, NTT_P3);
+
+    // Garner's CRT per coefficient, then carry-propagate in PIECE_BASE
+    const uint64_t p12 = (uint64_t)NTT_P1 * NTT_P2;
+    dlimb_t carry = 0;
+    limb_t low_piece = 0;
+    for(size_t i = 0; i < pieces; i++) {
+        if(i < pieces - 1) {
+            uint64_t x1 = res1[i];
+            uint64_t t2 = (res2[i] + NTT_P2 - x1 % NTT_P2) * NTT_P1_INV_P2 % NTT_P2;
+            uint64_t x12 = x1 + NTT_P1 * t2;
+            uint64_t t3 = (res3[i] + NTT_P3 - x12 % NTT_P3) * NTT_P12_INV_P3 % NTT_P3;
+            carry += x12 + (dlimb_t)p12 * t3;
+        }
+        limb_t piece = (limb_t)(carry % PIECE_BASE);
+        carry /= PIECE_BASE;
+        if(i & 1) {
+            r[i / 2] = low_piece + piece * PIECE_BASE;
+        } else {
+            low_piece = piece;
+        }
+    }
+
+    free(work);
+}
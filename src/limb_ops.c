@@ -0,0 +1,367 @@
+/**
+ * @file limb_ops.c
+ * @brief Implementation of low-level limb vector kernels
+ *
+ * Portable C versions of the carry-propagating primitives that every
+ * higher-level algorithm is built on. The hot primitives call through a
+ * table of kernels chosen once per process from the CPU's features, so
+ * one binary uses the x86-64 kernels in limb_x86.c wherever they run.
+ * Limbs are stored least significant first, either as full 64-bit words
+ * or, when built with ARBITRARY_INT_DECIMAL_LIMBS, as base 10^18 digits.
+ */
+
+#include "limb_ops.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+static limb_t add_n_generic(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t sum = a[i] + b[i] + carry;
+        carry = sum >= LIMB_BASE;
+        r[i] = carry ? sum - LIMB_BASE : sum;
+    }
+    return carry;
+}
+
+limb_t limbs_add_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for(; i < n && b; i++) {
+        limb_t sum = a[i] + b;
+        b = sum >= LIMB_BASE;
+        r[i] = b ? sum - LIMB_BASE : sum;
+    }
+    if(r != a) {
+        for(; i < n; i++) {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+#else
+static limb_t add_n_generic(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t sum = a[i] + carry;
+        carry = sum < carry;
+        sum += b[i];
+        carry += sum < b[i];
+        r[i] = sum;
+    }
+    return carry;
+}
+
+limb_t limbs_add_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for(; i < n && b; i++) {
+        limb_t sum = a[i] + b;
+        b = sum < b;
+        r[i] = sum;
+    }
+    if(r != a) {
+        for(; i < n; i++) {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+#endif
+
+limb_t limbs_add(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    limb_t carry = limbs_add_n(r, a, b, bn);
+    return limbs_add_1(r + bn, a + bn, an - bn, carry);
+}
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+static limb_t sub_n_generic(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t borrow = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t subtrahend = b[i] + borrow;
+        borrow = a[i] < subtrahend;
+        r[i] = borrow ? a[i] + LIMB_BASE - subtrahend : a[i] - subtrahend;
+    }
+    return borrow;
+}
+
+limb_t limbs_sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for(; i < n && b; i++) {
+        limb_t ai = a[i];
+        r[i] = ai < b ? ai + LIMB_BASE - b : ai - b;
+        b = ai < b;
+    }
+    if(r != a) {
+        for(; i < n; i++) {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+#else
+static limb_t sub_n_generic(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t borrow = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t ai = a[i];
+        limb_t diff = ai - b[i];
+        limb_t next = ai < b[i];
+        next += diff < borrow;
+        r[i] = diff - borrow;
+        borrow = next;
+    }
+    return borrow;
+}
+
+limb_t limbs_sub_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    size_t i = 0;
+    for(; i < n && b; i++) {
+        limb_t ai = a[i];
+        r[i] = ai - b;
+        b = ai < b;
+    }
+    if(r != a) {
+        for(; i < n; i++) {
+            r[i] = a[i];
+        }
+    }
+    return b;
+}
+#endif
+
+limb_t limbs_sub(limb_t *r, const limb_t *a, size_t an, const limb_t *b, size_t bn) {
+    limb_t borrow = limbs_sub_n(r, a, b, bn);
+    return limbs_sub_1(r + bn, a + bn, an - bn, borrow);
+}
+
+static limb_t mul_1_generic(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        carry = limb_split((dlimb_t)a[i] * b + carry, &r[i]);
+    }
+    return carry;
+}
+
+static limb_t addmul_1_generic(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        carry = limb_split((dlimb_t)a[i] * b + r[i] + carry, &r[i]);
+    }
+    return carry;
+}
+
+static limb_t submul_1_generic(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    limb_t carry = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t lo;
+        carry = limb_split((dlimb_t)a[i] * b + carry, &lo);
+        limb_t ri = r[i];
+        // ri + (LIMB_MAX - lo) + 1 wraps to ri - lo with binary limbs
+        r[i] = ri < lo ? ri + (LIMB_MAX - lo) + 1 : ri - lo;
+        carry += ri < lo;
+    }
+    return carry;
+}
+
+static limb_t divrem_1_generic(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    limb_t rem = 0;
+    for(size_t i = n; i-- > 0;) {
+        dlimb_t cur = limb_join(rem, a[i]);
+        q[i] = (limb_t)(cur / d);
+        rem = (limb_t)(cur % d);
+    }
+    return rem;
+}
+
+#ifdef LIMB_X86_KERNELS
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+// MULX and ADC work on binary words only, so decimal limbs gain nothing
+// from the x86-64 and ADX tiers beyond the vector adds
+#define X86_ADD_N add_n_generic
+#define X86_SUB_N sub_n_generic
+#define ADX_ADD_N limbs_add_n_avx2
+#define ADX_SUB_N limbs_sub_n_avx2
+#define ADX_MUL_1 mul_1_generic
+#define ADX_ADDMUL_1 addmul_1_generic
+#else
+// From Broadwell on (the first ADX CPUs) ADC is a single fast uop and
+// the scalar loop beats the four-lane AVX2 lookahead
+#define X86_ADD_N limbs_add_n_adc
+#define X86_SUB_N limbs_sub_n_adc
+#define ADX_ADD_N limbs_add_n_adc
+#define ADX_SUB_N limbs_sub_n_adc
+#define ADX_MUL_1 limbs_mul_1_adx
+#define ADX_ADDMUL_1 limbs_addmul_1_adx
+#endif
+#endif
+
+/** Names accepted in LIMB_TIER_ENV, indexed by LimbTier */
+static const char *const tier_names[LIMB_TIER_COUNT] = {
+    "generic", "x86-64", "avx2", "adx", "avx512"
+};
+
+/** Kernel tables indexed by LimbTier, up to the tiers this build has */
+static const LimbKernels kernel_tiers[LIMB_TIER_COUNT] = {
+    {LIMB_TIER_GENERIC, "generic", add_n_generic, sub_n_generic,
+     mul_1_generic, addmul_1_generic, submul_1_generic, divrem_1_generic},
+#ifdef LIMB_X86_KERNELS
+    {LIMB_TIER_X86_64, "x86-64", X86_ADD_N, X86_SUB_N,
+     mul_1_generic, addmul_1_generic, submul_1_generic, divrem_1_generic},
+    {LIMB_TIER_AVX2, "avx2", limbs_add_n_avx2, limbs_sub_n_avx2,
+     mul_1_generic, addmul_1_generic, submul_1_generic, divrem_1_generic},
+    {LIMB_TIER_ADX, "adx", ADX_ADD_N, ADX_SUB_N,
+     ADX_MUL_1, ADX_ADDMUL_1, submul_1_generic, divrem_1_generic},
+    {LIMB_TIER_AVX512, "avx512", limbs_add_n_avx512, limbs_sub_n_avx512,
+     ADX_MUL_1, ADX_ADDMUL_1, submul_1_generic, divrem_1_generic},
+#endif
+};
+
+#ifndef LIMB_X86_KERNELS
+LimbTier limbs_cpu_tier(void) {
+    return LIMB_TIER_GENERIC;
+}
+#endif
+
+/**
+ * @brief Picks the best supported tier, or the one named by LIMB_TIER_ENV
+ */
+static const LimbKernels* select_kernels(void) {
+    LimbTier best = limbs_cpu_tier();
+    const char *forced = getenv(LIMB_TIER_ENV);
+    if(!forced || !*forced) {
+        return &kernel_tiers[best];
+    }
+    for(int tier = 0; tier < LIMB_TIER_COUNT; tier++) {
+        if(strcmp(forced, tier_names[tier]) != 0) {
+            continue;
+        }
+        if(tier > (int)best) {
+            fprintf(stderr, "%s=%s is not supported by this CPU, using %s\n",
+                    LIMB_TIER_ENV, forced, kernel_tiers[best].name);
+            return &kernel_tiers[best];
+        }
+        return &kernel_tiers[tier];
+    }
+    fprintf(stderr, "Unknown %s=%s, using %s\n", LIMB_TIER_ENV, forced, kernel_tiers[best].name);
+    return &kernel_tiers[best];
+}
+
+static _Atomic(const LimbKernels *) active_kernels;
+
+const LimbKernels* limbs_kernels(void) {
+    const LimbKernels *kernels = atomic_load_explicit(&active_kernels, memory_order_acquire);
+    if(!kernels) {
+        // Threads racing here agree on the choice; only the first one
+        // publishes it
+        const LimbKernels *expected = NULL;
+        kernels = select_kernels();
+        if(!atomic_compare_exchange_strong(&active_kernels, &expected, kernels)) {
+            kernels = expected;
+        }
+    }
+    return kernels;
+}
+
+#ifdef __GNUC__
+/** Chooses the kernels when the library is loaded, before any thread starts */
+__attribute__((constructor))
+static void init_kernels(void) {
+    limbs_kernels();
+}
+#endif
+
+limb_t limbs_add_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return limbs_kernels()->add_n(r, a, b, n);
+}
+
+limb_t limbs_sub_n(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    return limbs_kernels()->sub_n(r, a, b, n);
+}
+
+limb_t limbs_mul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    return limbs_kernels()->mul_1(r, a, n, b);
+}
+
+limb_t limbs_addmul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    return limbs_kernels()->addmul_1(r, a, n, b);
+}
+
+limb_t limbs_submul_1(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    return limbs_kernels()->submul_1(r, a, n, b);
+}
+
+limb_t limbs_divrem_1(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    return limbs_kernels()->divrem_1(q, a, n, d);
+}
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+void limbs_divexact_1(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    limbs_divrem_1(q, a, n, d);
+}
+#else
+void limbs_divexact_1(limb_t *q, const limb_t *a, size_t n, limb_t d) {
+    // Strip the power of two with a shift
+    int shift = __builtin_ctzll(d);
+    if(shift) {
+        for(size_t i = 0; i + 1 < n; i++) {
+            q[i] = (a[i] >> shift) | (a[i + 1] << (LIMB_BITS - shift));
+        }
+        if(n > 0) {
+            q[n - 1] = a[n - 1] >> shift;
+        }
+        a = q;
+        d >>= shift;
+    }
+    if(d == 1) {
+        if(q != a) {
+            for(size_t i = 0; i < n; i++) {
+                q[i] = a[i];
+            }
+        }
+        return;
+    }
+
+    // Inverse of the odd part modulo 2^64 by Newton iteration
+    limb_t inv = (3 * d) ^ 2;
+    for(int i = 0; i < 4; i++) {
+        inv *= 2 - d * inv;
+    }
+
+    // Hensel division: each quotient limb is exact modulo 2^64
+    limb_t borrow = 0;
+    for(size_t i = 0; i < n; i++) {
+        limb_t s = a[i];
+        limb_t x = s - borrow;
+        borrow = s < borrow;
+        limb_t quot = x * inv;
+        q[i] = quot;
+        borrow += (limb_t)(((dlimb_t)quot * d) >> LIMB_BITS);
+    }
+}
+#endif
+
+int limbs_cmp(const limb_t *a, const limb_t *b, size_t n) {
+    for(size_t i = n; i-- > 0;) {
+        if(a[i] != b[i]) {
+            return a[i] > b[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+size_t limbs_normalized_size(const limb_t *a, size_t n) {
+    while(n > 0 && a[n - 1] == 0) {
+        n--;
+    }
+    return n;
+}
+
+limb_t* limbs_alloc(size_t n) {
+    limb_t *limbs = malloc((n ? n : 1) * sizeof(limb_t));
+    if(!limbs) {
+        perror("Failed to allocate limb scratch space");
+        exit(EXIT_FAILURE);
+    }
+    return limbs;
+}
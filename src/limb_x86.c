@@ -0,0 +1,478 @@
+/**
+ * @file limb_x86.c
+ * @brief x86-64 kernels for the limb primitives
+ *
+ * Each kernel is compiled for its instruction set with a target
+ * attribute or written in inline assembly, so the library still builds
+ * for the x86-64 baseline; limb_ops.c puts them in its dispatch table
+ * only for CPUs that support them.
+ */
+
+#include "limb_ops.h"
+
+#ifdef LIMB_X86_KERNELS
+#include <cpuid.h>
+#include <immintrin.h>
+
+/**
+ * @brief Reads an extended control register
+ *
+ * XCR0 tells which register states the operating system saves, and so
+ * whether the AVX and AVX-512 registers may be used at all.
+ */
+static uint64_t read_xcr(unsigned index) {
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a" (lo), "=d" (hi) : "c" (index));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+LimbTier limbs_cpu_tier(void) {
+    unsigned eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+        return LIMB_TIER_X86_64;
+    }
+    uint64_t xcr0 = read_xcr(0);
+    if((xcr0 & 0x6) != 0x6 || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2)) {
+        return LIMB_TIER_X86_64;
+    }
+    if(!(ebx & bit_BMI2) || !(ebx & bit_ADX)) {
+        return LIMB_TIER_AVX2;
+    }
+    // AVX-512 also needs the opmask and upper ZMM states enabled
+    if(!(ebx & bit_AVX512F) || (xcr0 & 0xe6) != 0xe6) {
+        return LIMB_TIER_ADX;
+    }
+    return LIMB_TIER_AVX512;
+}
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+/**
+ * @brief Finishes an addition limb by limb
+ * @param carry Carry into the first limb
+ * @return Carry out of the last limb
+ */
+static inline limb_t add_tail(limb_t *r, const limb_t *a, const limb_t *b, size_t n, limb_t carry) {
+    for(size_t i = 0; i < n; i++) {
+        limb_t sum = a[i] + b[i] + carry;
+        carry = sum >= LIMB_BASE;
+        r[i] = carry ? sum - LIMB_BASE : sum;
+    }
+    return carry;
+}
+
+/**
+ * @brief Finishes a subtraction limb by limb
+ * @param borrow Borrow into the first limb
+ * @return Borrow out of the last limb
+ */
+static inline limb_t sub_tail(limb_t *r, const limb_t *a, const limb_t *b, size_t n, limb_t borrow) {
+    for(size_t i = 0; i < n; i++) {
+        limb_t subtrahend = b[i] + borrow;
+        borrow = a[i] < subtrahend;
+        r[i] = borrow ? a[i] + LIMB_BASE - subtrahend : a[i] - subtrahend;
+    }
+    return borrow;
+}
+#else
+static inline limb_t add_tail(limb_t *r, const limb_t *a, const limb_t *b, size_t n, limb_t carry) {
+    for(size_t i = 0; i < n; i++) {
+        limb_t sum = a[i] + carry;
+        carry = sum < carry;
+        sum += b[i];
+        carry += sum < b[i];
+        r[i] = sum;
+    }
+    return carry;
+}
+
+static inline limb_t sub_tail(limb_t *r, const limb_t *a, const limb_t *b, size_t n, limb_t borrow) {
+    for(size_t i = 0; i < n; i++) {
+        limb_t ai = a[i];
+        limb_t d = ai - b[i];
+        limb_t next = ai < b[i];
+        next += d < borrow;
+        r[i] = d - borrow;
+        borrow = next;
+    }
+    return borrow;
+}
+#endif
+
+/**
+ * @brief Resolves carries across a block of lanes
+ * @param generate Lanes producing a carry on their own (bit mask)
+ * @param propagate Lanes passing an incoming carry on (bit mask)
+ * @param lanes Number of lanes in the block (4 or 8)
+ * @param carry Carry into the lowest lane, replaced by the carry out
+ * @return Lanes that receive an incoming carry, one bit per lane
+ *
+ * Carry lookahead as integer addition: adding the shifted generate bits
+ * and the carry in to the propagate mask ripples through runs of
+ * propagating lanes in one step. The masks never overlap.
+ */
+static inline unsigned resolve_carries(unsigned generate, unsigned propagate, unsigned lanes, limb_t *carry) {
+    unsigned ripple = propagate + ((generate << 1) | (unsigned)*carry);
+    *carry = ((ripple >> lanes) | (generate >> (lanes - 1))) & 1;
+    return (ripple ^ propagate) & ((1u << lanes) - 1);
+}
+
+/**
+ * @brief Expands a 4-bit lane mask to 0 or 1 in each 64-bit lane
+ */
+__attribute__((target("avx2")))
+static inline __m256i lane_ones(unsigned mask) {
+    __m256i bits = _mm256_srlv_epi64(_mm256_set1_epi64x((long long)mask), _mm256_setr_epi64x(0, 1, 2, 3));
+    return _mm256_and_si256(bits, _mm256_set1_epi64x(1));
+}
+
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+__attribute__((target("avx2")))
+limb_t limbs_add_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m256i base = _mm256_set1_epi64x((long long)LIMB_BASE);
+    const __m256i top = _mm256_set1_epi64x((long long)(LIMB_BASE - 1));
+    limb_t carry = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        // Lane sums stay below 2^63, so signed compares are exact
+        __m256i sum = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                       _mm256_loadu_si256((const __m256i *)(b + i)));
+        __m256i generate = _mm256_cmpgt_epi64(sum, top);
+        sum = _mm256_sub_epi64(sum, _mm256_and_si256(generate, base));
+        __m256i propagate = _mm256_cmpeq_epi64(sum, top);
+
+        unsigned incoming = resolve_carries((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                                            (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(propagate)),
+                                            4, &carry);
+        sum = _mm256_add_epi64(sum, lane_ones(incoming));
+        sum = _mm256_andnot_si256(_mm256_cmpeq_epi64(sum, base), sum);
+        _mm256_storeu_si256((__m256i *)(r + i), sum);
+    }
+    return add_tail(r + i, a + i, b + i, n - i, carry);
+}
+
+__attribute__((target("avx2")))
+limb_t limbs_sub_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m256i base = _mm256_set1_epi64x((long long)LIMB_BASE);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i minus_one = _mm256_set1_epi64x(-1);
+    limb_t borrow = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        // Lane differences lie in (-LIMB_BASE, LIMB_BASE)
+        __m256i diff = _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *)(a + i)),
+                                        _mm256_loadu_si256((const __m256i *)(b + i)));
+        __m256i generate = _mm256_cmpgt_epi64(zero, diff);
+        diff = _mm256_add_epi64(diff, _mm256_and_si256(generate, base));
+        __m256i propagate = _mm256_cmpeq_epi64(diff, zero);
+
+        unsigned incoming = resolve_carries((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                                            (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(propagate)),
+                                            4, &borrow);
+        diff = _mm256_sub_epi64(diff, lane_ones(incoming));
+        diff = _mm256_add_epi64(diff, _mm256_and_si256(_mm256_cmpeq_epi64(diff, minus_one), base));
+        _mm256_storeu_si256((__m256i *)(r + i), diff);
+    }
+    return sub_tail(r + i, a + i, b + i, n - i, borrow);
+}
+#else
+__attribute__((target("avx2")))
+limb_t limbs_add_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    limb_t carry = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i sum = _mm256_add_epi64(x, _mm256_loadu_si256((const __m256i *)(b + i)));
+
+        // Unsigned sum < x through signed compares on sign-flipped values
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(sum, sign));
+        __m256i propagate = _mm256_cmpeq_epi64(sum, ones);
+
+        unsigned incoming = resolve_carries((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                                            (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(propagate)),
+                                            4, &carry);
+        sum = _mm256_add_epi64(sum, lane_ones(incoming));
+        _mm256_storeu_si256((__m256i *)(r + i), sum);
+    }
+    return add_tail(r + i, a + i, b + i, n - i, carry);
+}
+
+__attribute__((target("avx2")))
+limb_t limbs_sub_n_avx2(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i zero = _mm256_setzero_si256();
+    limb_t borrow = 0;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i diff = _mm256_sub_epi64(x, y);
+
+        // Unsigned x < y through signed compares on sign-flipped values
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+        __m256i propagate = _mm256_cmpeq_epi64(diff, zero);
+
+        unsigned incoming = resolve_carries((unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                                            (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(propagate)),
+                                            4, &borrow);
+        diff = _mm256_sub_epi64(diff, lane_ones(incoming));
+        _mm256_storeu_si256((__m256i *)(r + i), diff);
+    }
+    return sub_tail(r + i, a + i, b + i, n - i, borrow);
+}
+#endif
+
+/*
+ * AVX-512 versions of the lookahead kernels: eight lanes per step, with
+ * unsigned compares and the lane masks read straight from the opmask
+ * registers.
+ */
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+__attribute__((target("avx512f")))
+limb_t limbs_add_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m512i base = _mm512_set1_epi64((long long)LIMB_BASE);
+    const __m512i top = _mm512_set1_epi64((long long)(LIMB_BASE - 1));
+    const __m512i one = _mm512_set1_epi64(1);
+    limb_t carry = 0;
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m512i sum = _mm512_add_epi64(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        __mmask8 generate = _mm512_cmpgt_epu64_mask(sum, top);
+        sum = _mm512_mask_sub_epi64(sum, generate, sum, base);
+        __mmask8 propagate = _mm512_cmpeq_epu64_mask(sum, top);
+
+        // Propagating lanes that receive a carry wrap from LIMB_MAX to 0
+        __mmask8 incoming = (__mmask8)resolve_carries(generate, propagate, 8, &carry);
+        sum = _mm512_mask_add_epi64(sum, incoming & ~propagate, sum, one);
+        sum = _mm512_mask_mov_epi64(sum, incoming & propagate, _mm512_setzero_si512());
+        _mm512_storeu_si512(r + i, sum);
+    }
+    return add_tail(r + i, a + i, b + i, n - i, carry);
+}
+
+__attribute__((target("avx512f")))
+limb_t limbs_sub_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m512i base = _mm512_set1_epi64((long long)LIMB_BASE);
+    const __m512i top = _mm512_set1_epi64((long long)(LIMB_BASE - 1));
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    limb_t borrow = 0;
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = _mm512_loadu_si512(b + i);
+        __mmask8 generate = _mm512_cmplt_epu64_mask(x, y);
+        __m512i diff = _mm512_sub_epi64(x, y);
+        diff = _mm512_mask_add_epi64(diff, generate, diff, base);
+        __mmask8 propagate = _mm512_cmpeq_epu64_mask(diff, zero);
+
+        // Propagating lanes that receive a borrow wrap from 0 to LIMB_MAX
+        __mmask8 incoming = (__mmask8)resolve_carries(generate, propagate, 8, &borrow);
+        diff = _mm512_mask_sub_epi64(diff, incoming & ~propagate, diff, one);
+        diff = _mm512_mask_mov_epi64(diff, incoming & propagate, top);
+        _mm512_storeu_si512(r + i, diff);
+    }
+    return sub_tail(r + i, a + i, b + i, n - i, borrow);
+}
+#else
+__attribute__((target("avx512f")))
+limb_t limbs_add_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i one = _mm512_set1_epi64(1);
+    limb_t carry = 0;
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i sum = _mm512_add_epi64(x, _mm512_loadu_si512(b + i));
+        __mmask8 generate = _mm512_cmplt_epu64_mask(sum, x);
+        __mmask8 propagate = _mm512_cmpeq_epu64_mask(sum, ones);
+
+        __mmask8 incoming = (__mmask8)resolve_carries(generate, propagate, 8, &carry);
+        sum = _mm512_mask_add_epi64(sum, incoming, sum, one);
+        _mm512_storeu_si512(r + i, sum);
+    }
+    return add_tail(r + i, a + i, b + i, n - i, carry);
+}
+
+__attribute__((target("avx512f")))
+limb_t limbs_sub_n_avx512(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    limb_t borrow = 0;
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = _mm512_loadu_si512(b + i);
+        __m512i diff = _mm512_sub_epi64(x, y);
+        __mmask8 generate = _mm512_cmplt_epu64_mask(x, y);
+        __mmask8 propagate = _mm512_cmpeq_epu64_mask(diff, zero);
+
+        __mmask8 incoming = (__mmask8)resolve_carries(generate, propagate, 8, &borrow);
+        diff = _mm512_mask_sub_epi64(diff, incoming, diff, one);
+        _mm512_storeu_si512(r + i, diff);
+    }
+    return sub_tail(r + i, a + i, b + i, n - i, borrow);
+}
+#endif
+
+#ifndef ARBITRARY_INT_DECIMAL_LIMBS
+/*
+ * The scalar kernels below run four limbs per loop iteration in inline
+ * assembly and finish the remaining n % 4 limbs in C. Loop counters are
+ * stepped with instructions that leave the carry chains intact: dec
+ * preserves CF, and lea + jrcxz preserve both CF and OF.
+ */
+
+limb_t limbs_mul_1_adx(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    limb_t carry = 0;
+    size_t blocks = n / 4;
+    if(blocks) {
+        limb_t lo, hi;
+        __asm__ volatile(
+            "xor %k[lo], %k[lo]\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo], %[hi]\n\t"
+            "adcx %[carry], %[lo]\n\t"
+            "mov %[lo], (%[r])\n\t"
+            "mulx 8(%[a]), %[lo], %[carry]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "mov %[lo], 8(%[r])\n\t"
+            "mulx 16(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[carry], %[lo]\n\t"
+            "mov %[lo], 16(%[r])\n\t"
+            "mulx 24(%[a]), %[lo], %[carry]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "mov %[lo], 24(%[r])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[r]), %[r]\n\t"
+            "dec %[blocks]\n\t"
+            "jnz 1b\n\t"
+            "mov $0, %k[lo]\n\t"
+            "adcx %[lo], %[carry]"
+            : [r] "+r" (r), [a] "+r" (a), [blocks] "+r" (blocks), [carry] "+r" (carry),
+              [lo] "=&r" (lo), [hi] "=&r" (hi)
+            : "d" (b)
+            : "cc", "memory");
+    }
+    for(size_t i = 0; i < n % 4; i++) {
+        carry = limb_split((dlimb_t)a[i] * b + carry, &r[i]);
+    }
+    return carry;
+}
+
+limb_t limbs_addmul_1_adx(limb_t *r, const limb_t *a, size_t n, limb_t b) {
+    limb_t carry = 0;
+    size_t blocks = n / 4;
+    if(blocks) {
+        limb_t lo, hi;
+        // Two carry chains: CF adds the previous high word into the low
+        // product, OF adds that sum into r
+        __asm__ volatile(
+            "xor %k[lo], %k[lo]\n\t"
+            "1:\n\t"
+            "mulx (%[a]), %[lo], %[hi]\n\t"
+            "adcx %[carry], %[lo]\n\t"
+            "adox (%[r]), %[lo]\n\t"
+            "mov %[lo], (%[r])\n\t"
+            "mulx 8(%[a]), %[lo], %[carry]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "adox 8(%[r]), %[lo]\n\t"
+            "mov %[lo], 8(%[r])\n\t"
+            "mulx 16(%[a]), %[lo], %[hi]\n\t"
+            "adcx %[carry], %[lo]\n\t"
+            "adox 16(%[r]), %[lo]\n\t"
+            "mov %[lo], 16(%[r])\n\t"
+            "mulx 24(%[a]), %[lo], %[carry]\n\t"
+            "adcx %[hi], %[lo]\n\t"
+            "adox 24(%[r]), %[lo]\n\t"
+            "mov %[lo], 24(%[r])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[r]), %[r]\n\t"
+            "lea -1(%[blocks]), %[blocks]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n"
+            "2:\n\t"
+            "mov $0, %k[lo]\n\t"
+            "adcx %[lo], %[carry]\n\t"
+            "adox %[lo], %[carry]"
+            : [r] "+r" (r), [a] "+r" (a), [blocks] "+c" (blocks), [carry] "+r" (carry),
+              [lo] "=&r" (lo), [hi] "=&r" (hi)
+            : "d" (b)
+            : "cc", "memory");
+    }
+    for(size_t i = 0; i < n % 4; i++) {
+        carry = limb_split((dlimb_t)a[i] * b + r[i] + carry, &r[i]);
+    }
+    return carry;
+}
+
+limb_t limbs_add_n_adc(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t carry = 0;
+    size_t blocks = n / 4;
+    if(blocks) {
+        limb_t t;
+        __asm__ volatile(
+            "clc\n\t"
+            "1:\n\t"
+            "mov (%[a]), %[t]\n\t"
+            "adc (%[b]), %[t]\n\t"
+            "mov %[t], (%[r])\n\t"
+            "mov 8(%[a]), %[t]\n\t"
+            "adc 8(%[b]), %[t]\n\t"
+            "mov %[t], 8(%[r])\n\t"
+            "mov 16(%[a]), %[t]\n\t"
+            "adc 16(%[b]), %[t]\n\t"
+            "mov %[t], 16(%[r])\n\t"
+            "mov 24(%[a]), %[t]\n\t"
+            "adc 24(%[b]), %[t]\n\t"
+            "mov %[t], 24(%[r])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[b]), %[b]\n\t"
+            "lea 32(%[r]), %[r]\n\t"
+            "dec %[blocks]\n\t"
+            "jnz 1b\n\t"
+            "adc $0, %[carry]"
+            : [r] "+r" (r), [a] "+r" (a), [b] "+r" (b), [blocks] "+r" (blocks),
+              [carry] "+r" (carry), [t] "=&r" (t)
+            :
+            : "cc", "memory");
+    }
+    return add_tail(r, a, b, n % 4, carry);
+}
+
+limb_t limbs_sub_n_adc(limb_t *r, const limb_t *a, const limb_t *b, size_t n) {
+    limb_t borrow = 0;
+    size_t blocks = n / 4;
+    if(blocks) {
+        limb_t t;
+        __asm__ volatile(
+            "clc\n\t"
+            "1:\n\t"
+            "mov (%[a]), %[t]\n\t"
+            "sbb (%[b]), %[t]\n\t"
+            "mov %[t], (%[r])\n\t"
+            "mov 8(%[a]), %[t]\n\t"
+            "sbb 8(%[b]), %[t]\n\t"
+            "mov %[t], 8(%[r])\n\t"
+            "mov 16(%[a]), %[t]\n\t"
+            "sbb 16(%[b]), %[t]\n\t"
+            "mov %[t], 16(%[r])\n\t"
+            "mov 24(%[a]), %[t]\n\t"
+            "sbb 24(%[b]), %[t]\n\t"
+            "mov %[t], 24(%[r])\n\t"
+            "lea 32(%[a]), %[a]\n\t"
+            "lea 32(%[b]), %[b]\n\t"
+            "lea 32(%[r]), %[r]\n\t"
+            "dec %[blocks]\n\t"
+            "jnz 1b\n\t"
+            "adc $0, %[borrow]"
+            : [r] "+r" (r), [a] "+r" (a), [b] "+r" (b), [blocks] "+r" (blocks),
+              [borrow] "+r" (borrow), [t] "=&r" (t)
+            :
+            : "cc", "memory");
+    }
+    return sub_tail(r, a, b, n % 4, borrow);
+}
+#endif
+#endif
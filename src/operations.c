@@ -4,30 +4,18 @@
  */
 
 #include "../include/operations.h"
+#include "../include/limb_ops.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 /**
  * @brief Addition wrapper function
  */
 ArbitraryInt* add(const ArbitraryInt *a, const ArbitraryInt *b) {
     if (!a || !b) return NULL;
-    
-    ArbitraryInt *result = malloc(sizeof(ArbitraryInt));
-    if (!result) return NULL;
-    
-    result->is_negative = false;
-    result->value = NULL;
-    
-    ArbitraryInt *temp = add_arbitrary_ints(a, b);
-    if (temp) {
-        result->is_negative = temp->is_negative;
-        result->value = strdup(temp->value);
-        free_arbitrary_int(temp);
-    }
-    
-    return result;
+    return add_arbitrary_ints(a, b);
 }
 
 ArbitraryInt* subtract(const ArbitraryInt *a, const ArbitraryInt *b) {
@@ -35,12 +23,39 @@ ArbitraryInt* subtract(const ArbitraryInt *a, const ArbitraryInt *b) {
 }
 
 ArbitraryInt* multiply(const ArbitraryInt *a, const ArbitraryInt *b) {
+    if(!a || !b) return NULL;
+
+    // a*a and a*(-a) only need the cheaper square of |a|
+    if(a == b || compare_arbitrary_int_magnitudes(a, b) == 0) {
+        ArbitraryInt *result = square(a);
+        if(result) {
+            result->is_negative = a->is_negative != b->is_negative;
+            normalize_arbitrary_int(result);
+        }
+        return result;
+    }
     return multiply_arbitrary_ints(a, b);
 }
 
+ArbitraryInt* square(const ArbitraryInt *a) {
+    if(!a || !a->limbs) return NULL;
+    if(a->size == 0) {
+        return allocate_arbitrary_int(1);
+    }
+
+    ArbitraryInt *result = allocate_arbitrary_int(2 * a->size);
+    if(!result) {
+        return NULL;
+    }
+    limbs_sqr(result->limbs, a->limbs, a->size);
+    result->size = 2 * a->size;
+    normalize_arbitrary_int(result);
+    return result;
+}
+
 ArbitraryInt* divide(const ArbitraryInt *a, const ArbitraryInt *b, ArbitraryInt **remainder) {
-    if(strcmp(b->value, "0") == 0) {
-        if(strcmp(a->value, "0") == 0) {
+    if(is_arbitrary_int_zero(b)) {
+        if(is_arbitrary_int_zero(a)) {
             // 0/0 = NaN
             fprintf(stderr, "Division by zero (NaN)\n");
             return NULL;
@@ -52,33 +67,40 @@ ArbitraryInt* divide(const ArbitraryInt *a, const ArbitraryInt *b, ArbitraryInt
         }
     }
 
-    ArbitraryInt *quotient = create_arbitrary_int("0");
-    ArbitraryInt *current = copy_arbitrary_int(a);
-    current->is_negative = false;
-    
-    ArbitraryInt *abs_b = copy_arbitrary_int(b);
-    abs_b->is_negative = false;
-    
-    while(compare_arbitrary_ints(current, abs_b) >= 0) {
-        ArbitraryInt *temp = subtract(current, abs_b);
-        ArbitraryInt *new_quotient = add(quotient, create_arbitrary_int("1"));
-        
-        free_arbitrary_int(current);
-        free_arbitrary_int(quotient);
-        
-        current = temp;
-        quotient = new_quotient;
+    // Truncating division; the remainder is |a| mod |b|
+    ArbitraryInt *quotient;
+    ArbitraryInt *rem;
+    if(compare_arbitrary_int_magnitudes(a, b) < 0) {
+        quotient = allocate_arbitrary_int(1);
+        rem = copy_arbitrary_int(a);
+        if(!quotient || !rem) {
+            free_arbitrary_int(quotient);
+            free_arbitrary_int(rem);
+            return NULL;
+        }
+    } else {
+        quotient = allocate_arbitrary_int(a->size - b->size + 1);
+        rem = allocate_arbitrary_int(b->size);
+        if(!quotient || !rem) {
+            free_arbitrary_int(quotient);
+            free_arbitrary_int(rem);
+            return NULL;
+        }
+        limbs_divrem(quotient->limbs, rem->limbs, a->limbs, a->size, b->limbs, b->size);
+        quotient->size = a->size - b->size + 1;
+        rem->size = b->size;
     }
-    
+    rem->is_negative = false;
+    normalize_arbitrary_int(rem);
+
     if(remainder) {
-        *remainder = current;
+        *remainder = rem;
     } else {
-        free_arbitrary_int(current);
+        free_arbitrary_int(rem);
     }
-    
+
     quotient->is_negative = (a->is_negative != b->is_negative);
-    free_arbitrary_int(abs_b);
-    
+    normalize_arbitrary_int(quotient);
     return quotient;
 }
 
@@ -89,95 +111,591 @@ ArbitraryInt* modulo(const ArbitraryInt *a, const ArbitraryInt *b) {
     return remainder;
 }
 
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+/** Unit whose powers make up the limb radix, and its count per limb */
+#define RADIX_UNIT 10
+#define UNITS_PER_LIMB LIMB_DIGITS
+#else
+#define RADIX_UNIT 2
+#define UNITS_PER_LIMB LIMB_BITS
+#endif
+
+/**
+ * @brief Converts a non-negative number to uint64_t
+ * @return false if the value does not fit
+ */
+static bool to_uint64(const ArbitraryInt *num, uint64_t *out) {
+    dlimb_t value = 0;
+    for(size_t i = num->size; i-- > 0;) {
+        value = value * limb_join(1, 0) + num->limbs[i];
+        if(value > UINT64_MAX) {
+            return false;
+        }
+    }
+    *out = (uint64_t)value;
+    return true;
+}
+
+/**
+ * @brief Returns RADIX_UNIT^k for k < UNITS_PER_LIMB
+ */
+static limb_t unit_power(uint64_t k) {
+    limb_t result = 1;
+    while(k--) {
+        result *= RADIX_UNIT;
+    }
+    return result;
+}
+
+/**
+ * @brief Counts the factors of RADIX_UNIT in a non-zero number
+ *
+ * That is trailing zero bits with binary limbs and trailing decimal
+ * zeros with decimal limbs.
+ */
+static uint64_t count_trailing_units(const ArbitraryInt *num) {
+    size_t i = 0;
+    while(num->limbs[i] == 0) {
+        i++;
+    }
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    limb_t low = num->limbs[i];
+    uint64_t count = 0;
+    while(low % 10 == 0) {
+        low /= 10;
+        count++;
+    }
+    return (uint64_t)i * UNITS_PER_LIMB + count;
+#else
+    return (uint64_t)i * UNITS_PER_LIMB + (uint64_t)__builtin_ctzll(num->limbs[i]);
+#endif
+}
+
+/**
+ * @brief Returns |num| * RADIX_UNIT^k, a shift in the limb radix
+ */
+static ArbitraryInt* shift_units_left(const ArbitraryInt *num, uint64_t k) {
+    uint64_t offset = k / UNITS_PER_LIMB;
+    if(offset >= SIZE_MAX / sizeof(limb_t) - num->size - 1) {
+        return NULL;
+    }
+    size_t size = num->size + (size_t)offset + 1;
+    ArbitraryInt *result = allocate_arbitrary_int(size);
+    if(!result) {
+        return NULL;
+    }
+    memset(result->limbs, 0, (size_t)offset * sizeof(limb_t));
+    result->limbs[size - 1] = limbs_mul_1(result->limbs + offset, num->limbs, num->size,
+                                          unit_power(k % UNITS_PER_LIMB));
+    result->size = size;
+    normalize_arbitrary_int(result);
+    return result;
+}
+
+/**
+ * @brief Returns |num| / RADIX_UNIT^k, where the division is exact
+ */
+static ArbitraryInt* shift_units_right(const ArbitraryInt *num, uint64_t k) {
+    size_t offset = (size_t)(k / UNITS_PER_LIMB);
+    size_t size = num->size - offset;
+    ArbitraryInt *result = allocate_arbitrary_int(size);
+    if(!result) {
+        return NULL;
+    }
+    limbs_divexact_1(result->limbs, num->limbs + offset, size, unit_power(k % UNITS_PER_LIMB));
+    result->size = size;
+    normalize_arbitrary_int(result);
+    return result;
+}
+
+/**
+ * @brief Replaces *x with *x * y
+ * @return false on allocation failure, leaving *x unchanged
+ */
+static bool multiply_into(ArbitraryInt **x, const ArbitraryInt *y) {
+    ArbitraryInt *product = multiply(*x, y);
+    if(!product) {
+        return false;
+    }
+    free_arbitrary_int(*x);
+    *x = product;
+    return true;
+}
+
+/**
+ * @brief Left-to-right sliding-window exponentiation
+ * @param base Base, |base| > 1
+ * @param exponent Exponent, at least 1
+ *
+ * Scans the exponent from the top bit, squaring once per bit and
+ * multiplying by a precomputed odd power base^(2j+1) once per window of
+ * up to w bits, which needs about log2(e) squarings and log2(e)/(w+1)
+ * multiplications.
+ */
+static ArbitraryInt* power_sliding_window(const ArbitraryInt *base, uint64_t exponent) {
+    int bits = 64 - __builtin_clzll(exponent);
+    int window = bits < 8 ? 1 : bits < 24 ? 3 : bits < 48 ? 4 : 5;
+    size_t table_size = (size_t)1 << (window - 1);
+
+    // table[j] = base^(2j+1)
+    ArbitraryInt *table[16] = {NULL};
+    ArbitraryInt *base_squared = NULL;
+    ArbitraryInt *result = NULL;
+    bool ok = (table[0] = copy_arbitrary_int(base)) != NULL;
+    if(ok && table_size > 1) {
+        ok = (base_squared = square(base)) != NULL;
+    }
+    for(size_t j = 1; ok && j < table_size; j++) {
+        ok = (table[j] = multiply(table[j - 1], base_squared)) != NULL;
+    }
+
+    int i = bits - 1;
+    while(ok && i >= 0) {
+        if(!((exponent >> i) & 1)) {
+            ok = multiply_into(&result, result);
+            i--;
+            continue;
+        }
+
+        // Longest window i..low ending in a set bit
+        int low = (i - window + 1 < 0) ? 0 : i - window + 1;
+        while(!((exponent >> low) & 1)) {
+            low++;
+        }
+        uint64_t value = (exponent >> low) & ((UINT64_C(1) << (i - low + 1)) - 1);
+
+        if(result) {
+            for(int k = low; ok && k <= i; k++) {
+                ok = multiply_into(&result, result);
+            }
+            ok = ok && multiply_into(&result, table[value >> 1]);
+        } else {
+            ok = (result = copy_arbitrary_int(table[value >> 1])) != NULL;
+        }
+        i = low - 1;
+    }
+
+    for(size_t j = 0; j < table_size; j++) {
+        free_arbitrary_int(table[j]);
+    }
+    free_arbitrary_int(base_squared);
+    if(!ok) {
+        free_arbitrary_int(result);
+        return NULL;
+    }
+    return result;
+}
+
 ArbitraryInt* power(const ArbitraryInt *base, const ArbitraryInt *exponent) {
     if(exponent->is_negative) {
         fprintf(stderr, "Negative exponents not supported\n");
         return NULL;
     }
-    
-    ArbitraryInt *result = create_arbitrary_int("1");
-    ArbitraryInt *i = create_arbitrary_int("0");
-    
-    while(compare_arbitrary_ints(i, exponent) < 0) {
-        ArbitraryInt *temp = multiply(result, base);
+
+    // Fast paths that work for any exponent size
+    bool negative = base->is_negative && !is_arbitrary_int_zero(exponent) && (exponent->limbs[0] & 1);
+    if(is_arbitrary_int_zero(exponent)) {
+        return create_arbitrary_int_from_uint(1);
+    }
+    if(is_arbitrary_int_zero(base)) {
+        return create_arbitrary_int_from_uint(0);
+    }
+    if(base->size == 1 && base->limbs[0] == 1) {
+        ArbitraryInt *result = create_arbitrary_int_from_uint(1);
+        if(result) {
+            result->is_negative = negative;
+        }
+        return result;
+    }
+
+    uint64_t e;
+    if(!to_uint64(exponent, &e)) {
+        fprintf(stderr, "Exponent too large\n");
+        return NULL;
+    }
+
+    // base = m * RADIX_UNIT^t gives base^e = m^e * RADIX_UNIT^(t*e), where
+    // the second factor is a plain shift; powers of two (binary limbs) or
+    // ten (decimal limbs) reduce to the shift alone
+    uint64_t t = count_trailing_units(base);
+    if(t > 0 && t > UINT64_MAX / e) {
+        fprintf(stderr, "Result too large\n");
+        return NULL;
+    }
+    ArbitraryInt *m = shift_units_right(base, t);
+    if(!m) {
+        return NULL;
+    }
+
+    ArbitraryInt *result;
+    if(m->size == 1 && m->limbs[0] == 1) {
+        result = create_arbitrary_int_from_uint(1);
+    } else {
+        result = power_sliding_window(m, e);
+    }
+    free_arbitrary_int(m);
+
+    if(result && t > 0) {
+        ArbitraryInt *shifted = shift_units_left(result, t * e);
         free_arbitrary_int(result);
-        result = temp;
-        
-        ArbitraryInt *new_i = add(i, create_arbitrary_int("1"));
-        free_arbitrary_int(i);
-        i = new_i;
+        result = shifted;
     }
-    
-    free_arbitrary_int(i);
+    if(!result) {
+        fprintf(stderr, "Result too large\n");
+        return NULL;
+    }
+    result->is_negative = negative;
+    return result;
+}
+
+/** Leaf size (in limbs) below which product_tree multiplies sequentially */
+#define PRODUCT_TREE_LEAF 16
+
+/**
+ * @brief Multiplies count single-limb factors with a balanced product tree
+ *
+ * Splitting the list in halves keeps both operands of every product about
+ * the same size, so large products reach the fast multiplication tiers.
+ */
+static ArbitraryInt* product_tree(const limb_t *factors, size_t count) {
+    if(count <= PRODUCT_TREE_LEAF) {
+        ArbitraryInt *result = allocate_arbitrary_int(count + 1);
+        if(!result) {
+            return NULL;
+        }
+        result->limbs[0] = 1;
+        result->size = 1;
+        for(size_t i = 0; i < count; i++) {
+            result->limbs[result->size] = limbs_mul_1(result->limbs, result->limbs, result->size, factors[i]);
+            result->size++;
+        }
+        normalize_arbitrary_int(result);
+        return result;
+    }
+
+    ArbitraryInt *low = product_tree(factors, count / 2);
+    ArbitraryInt *high = product_tree(factors + count / 2, count - count / 2);
+    ArbitraryInt *result = (low && high) ? multiply(high, low) : NULL;
+    free_arbitrary_int(low);
+    free_arbitrary_int(high);
+    return result;
+}
+
+/**
+ * @brief Odd part of the swinging factorial n! / (floor(n/2)!)^2
+ * @param primes Odd primes in increasing order, covering all primes <= n
+ * @param scratch Room for one limb per prime
+ *
+ * The exponent of p in the swing is the number of odd quotients
+ * floor(n/p^k), k >= 1, and p^e never exceeds n. The prime powers are
+ * packed into limbs before going through the product tree.
+ */
+static ArbitraryInt* odd_swing(uint64_t n, const limb_t *primes, size_t prime_count, limb_t *scratch) {
+    size_t count = 0;
+    limb_t packed = 1;
+    for(size_t i = 0; i < prime_count && primes[i] <= n; i++) {
+        limb_t p = primes[i];
+        limb_t prime_power = 1;
+        for(uint64_t q = n / p; q > 0; q /= p) {
+            if(q & 1) {
+                prime_power *= p;
+            }
+        }
+        if(prime_power == 1) {
+            continue;
+        }
+        if((dlimb_t)packed * prime_power > LIMB_MAX) {
+            scratch[count++] = packed;
+            packed = prime_power;
+        } else {
+            packed *= prime_power;
+        }
+    }
+    scratch[count++] = packed;
+    return product_tree(scratch, count);
+}
+
+/**
+ * @brief Odd part of n!, from odd(n!) = odd(floor(n/2)!)^2 * odd_swing(n)
+ */
+static ArbitraryInt* odd_factorial(uint64_t n, const limb_t *primes, size_t prime_count, limb_t *scratch) {
+    if(n < 3) {
+        return create_arbitrary_int_from_uint(1);
+    }
+
+    ArbitraryInt *half = odd_factorial(n / 2, primes, prime_count, scratch);
+    ArbitraryInt *half_squared = half ? square(half) : NULL;
+    free_arbitrary_int(half);
+    ArbitraryInt *swing = half_squared ? odd_swing(n, primes, prime_count, scratch) : NULL;
+    ArbitraryInt *result = swing ? multiply(half_squared, swing) : NULL;
+    free_arbitrary_int(half_squared);
+    free_arbitrary_int(swing);
     return result;
 }
 
+/**
+ * @brief Lists the odd primes up to n with a sieve of Eratosthenes
+ * @return Newly allocated prime list; its length goes to *count
+ */
+static limb_t* odd_primes_up_to(uint64_t n, size_t *count) {
+    // sieve[i] stands for the odd number 2i+1
+    size_t half = (size_t)(n + 1) / 2;
+    char *composite = calloc(half + 1, 1);
+    limb_t *primes = malloc((half + 1) * sizeof(limb_t));
+    if(!composite || !primes) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(composite);
+        free(primes);
+        return NULL;
+    }
+
+    *count = 0;
+    for(size_t i = 1; i < half; i++) {
+        if(composite[i]) {
+            continue;
+        }
+        size_t p = 2 * i + 1;
+        primes[(*count)++] = p;
+        for(size_t j = p * p / 2; j < half; j += p) {
+            composite[j] = 1;
+        }
+    }
+    free(composite);
+    return primes;
+}
+
+/** Largest n accepted by factorial(); n! then has about 2^37 bits */
+#define FACTORIAL_MAX ((uint64_t)1 << 32)
+
 ArbitraryInt* factorial(const ArbitraryInt *n) {
     if(n->is_negative) {
         fprintf(stderr, "Factorial of negative number undefined\n");
         return NULL;
     }
-    
-    ArbitraryInt *result = create_arbitrary_int("1");
-    ArbitraryInt *i = create_arbitrary_int("1");
-    
-    while(compare_arbitrary_ints(i, n) <= 0) {
-        ArbitraryInt *temp = multiply(result, i);
-        free_arbitrary_int(result);
-        result = temp;
-        
-        ArbitraryInt *new_i = add(i, create_arbitrary_int("1"));
-        free_arbitrary_int(i);
-        i = new_i;
+
+    uint64_t value;
+    if(!to_uint64(n, &value) || value > FACTORIAL_MAX) {
+        fprintf(stderr, "Factorial argument too large\n");
+        return NULL;
     }
-    
-    free_arbitrary_int(i);
+
+    // Luschny's prime-swing algorithm on the odd part, then n! gets its
+    // n - popcount(n) factors of two back in one step
+    size_t prime_count;
+    limb_t *primes = odd_primes_up_to(value, &prime_count);
+    if(!primes) {
+        return NULL;
+    }
+    limb_t *scratch = limbs_alloc(prime_count + 1);
+    ArbitraryInt *odd = odd_factorial(value, primes, prime_count, scratch);
+    free(scratch);
+    free(primes);
+    if(!odd) {
+        return NULL;
+    }
+
+    uint64_t twos = value - (uint64_t)__builtin_popcountll(value);
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    ArbitraryInt *two = create_arbitrary_int_from_uint(2);
+    ArbitraryInt *exponent = create_arbitrary_int_from_uint(twos);
+    ArbitraryInt *power_of_two = (two && exponent) ? power(two, exponent) : NULL;
+    ArbitraryInt *result = power_of_two ? multiply(odd, power_of_two) : NULL;
+    free_arbitrary_int(two);
+    free_arbitrary_int(exponent);
+    free_arbitrary_int(power_of_two);
+#else
+    ArbitraryInt *result = shift_units_left(odd, twos);
+#endif
+    free_arbitrary_int(odd);
     return result;
 }
 
 ArbitraryInt* copy_arbitrary_int(const ArbitraryInt *num) {
-    ArbitraryInt *copy = create_arbitrary_int(num->value);
+    ArbitraryInt *copy = allocate_arbitrary_int(num->size);
+    if (!copy) return NULL;
+    memcpy(copy->limbs, num->limbs, num->size * sizeof(limb_t));
+    copy->size = num->size;
     copy->is_negative = num->is_negative;
     return copy;
 }
 
+/**
+ * @brief Counts the RADIX_UNIT digits of a non-zero number
+ *
+ * That is the bit length with binary limbs and the decimal digit count
+ * with decimal limbs.
+ */
+static uint64_t count_units(const ArbitraryInt *num) {
+    limb_t top = num->limbs[num->size - 1];
+#ifdef ARBITRARY_INT_DECIMAL_LIMBS
+    uint64_t top_units = 0;
+    while(top) {
+        top /= 10;
+        top_units++;
+    }
+#else
+    uint64_t top_units = LIMB_BITS - (uint64_t)__builtin_clzll(top);
+#endif
+    return (uint64_t)(num->size - 1) * UNITS_PER_LIMB + top_units;
+}
+
+/**
+ * @brief Natural logarithm of a non-zero magnitude from its top two limbs
+ *
+ * The dropped limbs change the result by less than 2^-100 relative, far
+ * below double rounding.
+ */
+static double log_magnitude(const ArbitraryInt *num) {
+    double radix = (double)limb_join(1, 0);
+    size_t n = num->size;
+    double top = (double)num->limbs[n - 1];
+    size_t dropped = n - 1;
+    if(n > 1) {
+        top = top * radix + (double)num->limbs[n - 2];
+        dropped--;
+    }
+    return log(top) + (double)dropped * log(radix);
+}
+
 ArbitraryInt* logarithm(const ArbitraryInt *num, const ArbitraryInt *base) {
     if(base->is_negative || num->is_negative) {
         fprintf(stderr, "Logarithm not defined for negative numbers\n");
         return NULL;
     }
     
-    if(strcmp(base->value, "1") == 0 || strcmp(base->value, "0") == 0) {
+    if(base->size == 0 || (base->size == 1 && base->limbs[0] == 1)) {
         fprintf(stderr, "Invalid base for logarithm\n");
         return NULL;
     }
     
-    if(strcmp(num->value, "0") == 0) {
+    if(is_arbitrary_int_zero(num)) {
         fprintf(stderr, "Logarithm not defined for zero\n");
         return NULL;
     }
-    
-    // Initialize result
-    ArbitraryInt *result = create_arbitrary_int("0");
-    ArbitraryInt *current = create_arbitrary_int("1");
-    
-    // While current <= num
-    while(compare_arbitrary_ints(current, num) <= 0) {
-        // Multiply current by base
-        ArbitraryInt *next = multiply(current, base);
-        free_arbitrary_int(current);
-        current = next;
-        
-        // Increment result
-        ArbitraryInt *new_result = add(result, create_arbitrary_int("1"));
-        free_arbitrary_int(result);
-        result = new_result;
+
+    // Exact for base = RADIX_UNIT^t: num has count_units(num) digits in
+    // that unit, so floor(log) = (digits - 1) / t
+    uint64_t t = count_trailing_units(base);
+    if(t > 0 && base->size - 1 == t / UNITS_PER_LIMB &&
+       base->limbs[base->size - 1] == unit_power(t % UNITS_PER_LIMB)) {
+        return create_arbitrary_int_from_uint((count_units(num) - 1) / t);
     }
-    
-    // Adjust result since we went one step too far
-    ArbitraryInt *final = subtract(result, create_arbitrary_int("1"));
-    free_arbitrary_int(result);
-    free_arbitrary_int(current);
-    
-    return final;
+
+    // The quotient of the double logs is good to about 1e-15 relative,
+    // so its floor is exact unless it sits that close to an integer
+    double estimate = log_magnitude(num) / log_magnitude(base);
+    uint64_t e = (uint64_t)estimate;
+    double fraction = estimate - (double)e;
+    double margin = 1e-12 * (estimate + 1);
+    if(fraction > margin && fraction < 1 - margin) {
+        return create_arbitrary_int_from_uint(e);
+    }
+
+    // Near an integer the floor may be off by one either way: settle it
+    // against base^e
+    ArbitraryInt *exponent = create_arbitrary_int_from_uint(e);
+    ArbitraryInt *p = exponent ? power(base, exponent) : NULL;
+    free_arbitrary_int(exponent);
+    if(!p) {
+        return NULL;
+    }
+    if(compare_arbitrary_int_magnitudes(p, num) > 0) {
+        e--;
+    } else {
+        ArbitraryInt *next = multiply(p, base);
+        if(!next) {
+            free_arbitrary_int(p);
+            return NULL;
+        }
+        if(compare_arbitrary_int_magnitudes(next, num) <= 0) {
+            e++;
+        }
+        free_arbitrary_int(next);
+    }
+    free_arbitrary_int(p);
+    return create_arbitrary_int_from_uint(e);
+}
+
+ArbitraryInt* gcd(const ArbitraryInt *a, const ArbitraryInt *b) {
+    if(!a || !b) return NULL;
+    if(is_arbitrary_int_zero(a) || is_arbitrary_int_zero(b)) {
+        ArbitraryInt *result = copy_arbitrary_int(is_arbitrary_int_zero(a) ? b : a);
+        if(result) {
+            result->is_negative = false;
+        }
+        return result;
+    }
+
+    size_t size = a->size < b->size ? a->size : b->size;
+    ArbitraryInt *result = allocate_arbitrary_int(size);
+    if(!result) {
+        return NULL;
+    }
+    result->size = limbs_gcd(result->limbs, a->limbs, a->size, b->limbs, b->size);
+    return result;
+}
+
+/**
+ * @brief Returns -1, 0 or 1 following the sign of num
+ */
+static ArbitraryInt* sign_of(const ArbitraryInt *num) {
+    ArbitraryInt *result = create_arbitrary_int_from_uint(is_arbitrary_int_zero(num) ? 0 : 1);
+    if(result) {
+        result->is_negative = num->is_negative;
+        normalize_arbitrary_int(result);
+    }
+    return result;
+}
+
+ArbitraryInt* gcdext(const ArbitraryInt *a, const ArbitraryInt *b, ArbitraryInt **s, ArbitraryInt **t) {
+    if(!a || !b) return NULL;
+
+    ArbitraryInt *g;
+    ArbitraryInt *s_value;
+    ArbitraryInt *t_value;
+    if(is_arbitrary_int_zero(a) || is_arbitrary_int_zero(b)) {
+        // gcd(a, 0) = |a| = a * sign(a)
+        bool a_zero = is_arbitrary_int_zero(a);
+        g = gcd(a, b);
+        s_value = a_zero ? create_arbitrary_int_from_uint(0) : sign_of(a);
+        t_value = a_zero ? sign_of(b) : create_arbitrary_int_from_uint(0);
+    } else {
+        size_t max_size = a->size > b->size ? a->size : b->size;
+        size_t min_size = a->size < b->size ? a->size : b->size;
+        g = allocate_arbitrary_int(min_size);
+        s_value = allocate_arbitrary_int(max_size + 1);
+        t_value = NULL;
+        if(g && s_value) {
+            bool s_negative;
+            g->size = limbs_gcdext(g->limbs, s_value->limbs, &s_value->size, &s_negative,
+                                   a->limbs, a->size, b->limbs, b->size);
+            s_value->is_negative = s_negative != a->is_negative;
+            normalize_arbitrary_int(s_value);
+
+            // t = (g - a*s) / b, an exact division
+            ArbitraryInt *as = multiply(a, s_value);
+            ArbitraryInt *rest = as ? subtract(g, as) : NULL;
+            t_value = rest ? divide(rest, b, NULL) : NULL;
+            free_arbitrary_int(as);
+            free_arbitrary_int(rest);
+        }
+    }
+
+    if(!g || !s_value || !t_value) {
+        free_arbitrary_int(g);
+        free_arbitrary_int(s_value);
+        free_arbitrary_int(t_value);
+        return NULL;
+    }
+    if(s) {
+        *s = s_value;
+    } else {
+        free_arbitrary_int(s_value);
+    }
+    if(t) {
+        *t = t_value;
+    } else {
+        free_arbitrary_int(t_value);
+    }
+    return g;
 }
@@ -5,33 +5,46 @@
 #include <assert.h>
 #include "../include/ArbitraryInt.h"
 
+/**
+ * @brief Checks the decimal digits of a number's magnitude
+ * @param num Number to check
+ * @param digits Expected digits without sign
+ * @return true if |num| prints as digits
+ */
+static bool has_value(const ArbitraryInt *num, const char *digits) {
+    char *str = arbitrary_int_to_string(num);
+    bool equal = str && strcmp(str + (str[0] == '-'), digits) == 0;
+    free(str);
+    return equal;
+}
+
 void test_creation() {
     printf("Testing ArbitraryInt creation...\n");
     
     ArbitraryInt *num = create_arbitrary_int("12345");
     assert(num != NULL);
-    assert(strcmp(num->value, "12345") == 0);
+    assert(has_value(num, "12345"));
     assert(num->is_negative == false);
     free_arbitrary_int(num);
     
     // Test negative number
     num = create_arbitrary_int("-54321");
     assert(num != NULL);
-    assert(strcmp(num->value, "54321") == 0);
+    assert(has_value(num, "54321"));
     assert(num->is_negative == true);
     free_arbitrary_int(num);
     
     // Test zero
     num = create_arbitrary_int("0");
     assert(num != NULL);
-    assert(strcmp(num->value, "0") == 0);
+    assert(has_value(num, "0"));
     assert(num->is_negative == false);
     free_arbitrary_int(num);
     
     // Test leading zeros
     num = create_arbitrary_int("00123");
     assert(num != NULL);
-    assert(strcmp(num->value, "123") == 0);
+    assert(has_value(num, "123"));
     free_arbitrary_int(num);
     
     printf("Creation tests passed!\n");
@@ -67,15 +80,15 @@ void test_basic_arithmetic() {
     ArbitraryInt *b = create_arbitrary_int("456");
     
     ArbitraryInt *sum = add_arbitrary_ints(a, b);
-    assert(strcmp(sum->value, "579") == 0);
+    assert(has_value(sum, "579"));
     free_arbitrary_int(sum);
     
     ArbitraryInt *diff = subtract_arbitrary_ints(b, a);
-    assert(strcmp(diff->value, "333") == 0);
+    assert(has_value(diff, "333"));
     free_arbitrary_int(diff);
     
     ArbitraryInt *prod = multiply_arbitrary_ints(a, b);
-    assert(strcmp(prod->value, "56088") == 0);
+    assert(has_value(prod, "56088"));
     free_arbitrary_int(prod);
     
     free_arbitrary_int(a);
@@ -84,12 +97,99 @@ void test_basic_arithmetic() {
     printf("Basic arithmetic tests passed!\n");
 }
 
+/**
+ * @brief Tests parsing of long digit strings
+ *
+ * Covers the vectorized validation and 16-digit conversion, and the
+ * pairwise chunk combine used for long inputs with binary limbs.
+ */
+void test_long_parsing() {
+    printf("Testing long number parsing...\n");
+
+    char *digits = malloc(3041);
+    memset(digits, '0', 40);
+    for(int i = 40; i < 3040; i++) {
+        digits[i] = (char)('0' + (i * 7 + i / 13) % 10);
+    }
+    digits[40] = '9';
+    digits[3040] = '\0';
+
+    ArbitraryInt *num = create_arbitrary_int(digits);
+    assert(num != NULL);
+    assert(has_value(num, digits + 40));
+    free_arbitrary_int(num);
+
+    // 10^2999 is a single one and zero chunks
+    memset(digits + 41, '0', 2999);
+    digits[40] = '1';
+    num = create_arbitrary_int(digits);
+    assert(num != NULL && !num->is_negative);
+    assert(has_value(num, digits + 40));
+    free_arbitrary_int(num);
+
+    // A bad character anywhere rejects the whole string
+    digits[2000] = ':';
+    assert(create_arbitrary_int(digits) == NULL);
+    digits[2000] = (char)0xB0;
+    assert(create_arbitrary_int(digits) == NULL);
+
+    free(digits);
+    printf("Long parsing tests passed!\n");
+}
+
+/**
+ * @brief Tests decimal formatting into caller buffers
+ *
+ * Verifies to_decimal_string() lengths, the too-small buffer case, and
+ * that long values (split by powers of ten with binary limbs) match their
+ * input digits.
+ */
+void test_decimal_formatting() {
+    printf("Testing decimal formatting...\n");
+
+    char small[8];
+    ArbitraryInt *num = create_arbitrary_int("0");
+    assert(to_decimal_string(num, small, sizeof(small)) == 1 && strcmp(small, "0") == 0);
+    free_arbitrary_int(num);
+
+    num = create_arbitrary_int("-1234567");
+    memset(small, '#', sizeof(small));
+    assert(to_decimal_string(num, small, 8) == 8 && small[0] == '#');
+    char exact[9];
+    assert(to_decimal_string(num, exact, sizeof(exact)) == 8 && strcmp(exact, "-1234567") == 0);
+    free_arbitrary_int(num);
+
+    // -(10^3000 - 1) is all nines; a 1 then zeros checks zero padding
+    char *digits = malloc(3002);
+    char *text = malloc(3002);
+    digits[0] = '-';
+    memset(digits + 1, '9', 3000);
+    digits[3001] = '\0';
+    for(int i = 0; i < 2; i++) {
+        num = create_arbitrary_int(digits);
+        assert(to_decimal_string(num, text, 3002) == 3001 && strcmp(text, digits) == 0);
+        char *str = arbitrary_int_to_string(num);
+        assert(strcmp(str, digits) == 0);
+        free(str);
+        free_arbitrary_int(num);
+
+        digits[1] = '1';
+        memset(digits + 2, '0', 2999);
+    }
+
+    free(digits);
+    free(text);
+    printf("Decimal formatting tests passed!\n");
+}
+
 int main() {
     printf("Starting ArbitraryInt tests...\n\n");
     
     test_creation();
     test_comparison();
     test_basic_arithmetic();
+    test_long_parsing();
+    test_decimal_formatting();
     
     printf("\nAll ArbitraryInt tests passed successfully!\n");
     return 0;
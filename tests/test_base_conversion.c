@@ -15,6 +15,20 @@
 #include <string.h>
 #include "../include/base_conversion.h"
 #include "../include/ArbitraryInt.h"
+#include "../include/operations.h"
+
+/**
+ * @brief Checks the decimal digits of a number's magnitude
+ * @param num Number to check
+ * @param digits Expected digits without sign
+ * @return true if |num| prints as digits
+ */
+static bool has_value(const ArbitraryInt *num, const char *digits) {
+    char *str = arbitrary_int_to_string(num);
+    bool equal = str && strcmp(str + (str[0] == '-'), digits) == 0;
+    free(str);
+    return equal;
+}
 
 /**
  * @brief Tests decimal to binary conversion
@@ -96,14 +110,16 @@ void test_hex_to_decimal() {
         const char* expected = test_cases[i][1];
         
         ArbitraryInt *result = from_base(input, 16);
-        if (!result || !result->value) {
+        if (!result) {
             printf("FAILED: Could not convert '%s'\n", input);
             continue;
         }
         
-        if (strcmp(result->value, expected) != 0) {
+        if (!has_value(result, expected)) {
+            char *actual = arbitrary_int_to_string(result);
             printf("FAILED: '%s' -> expected '%s', got '%s'\n", 
-                   input, expected, result->value);
+                   input, expected, actual);
+            free(actual);
         }
         
         free_arbitrary_int(result);
@@ -124,6 +140,13 @@ void test_invalid_inputs() {
     // Test invalid characters
     ArbitraryInt *result2 = from_base("G", 16);
     assert(result2 == NULL);
+
+    // Invalid characters inside and after a 16-character block
+    const char *invalid[] = {"0123456789abcdef0123456789abcdeG012", "1111111111111111111111112", "7fffffffffffffff:", "1 2"};
+    int invalid_bases[] = {16, 2, 16, 10};
+    for(size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); i++) {
+        assert(from_base(invalid[i], invalid_bases[i]) == NULL);
+    }
     
     printf("Invalid input tests passed!\n");
 }
@@ -146,6 +169,17 @@ void test_arbitrary_bases() {
     assert(strcmp(base36, "16") == 0);
     free(base36);
     free_arbitrary_int(num);
+
+    // Letters up to Z in either case
+    ArbitraryInt *parsed = from_base("zZ", 36);
+    assert(parsed != NULL && has_value(parsed, "1295"));
+    free_arbitrary_int(parsed);
+    parsed = from_base("-vV0123456789abcdefghijklmnopqrstu", 32);
+    assert(parsed != NULL && parsed->is_negative);
+    char *base32 = to_base(parsed, 32);
+    assert(strcmp(base32, "-VV0123456789ABCDEFGHIJKLMNOPQRSTU") == 0);
+    free(base32);
+    free_arbitrary_int(parsed);
     
     printf("Arbitrary base conversion tests passed!\n");
 }
@@ -164,7 +198,7 @@ void test_base_roundtrip() {
         
         ArbitraryInt *back = from_base(converted, bases[i]);
         assert(back != NULL);
-        assert(strcmp(back->value, "42") == 0);
+        assert(has_value(back, "42"));
         
         free(converted);
         free_arbitrary_int(back);
@@ -174,6 +208,144 @@ void test_base_roundtrip() {
     printf("Base conversion roundtrip tests passed!\n");
 }
 
+/**
+ * @brief Tests to_base on values large enough for divide and conquer
+ *
+ * Verifies:
+ * - 7^5000 in base 7 is 1 followed by 5000 zeros (zero padded halves)
+ * - -(16^4000 - 1) in base 16 is a minus sign and 4000 F digits
+ * - Base 10 output matches arbitrary_int_to_string
+ */
+void test_large_to_base() {
+    printf("Testing large to_base conversions...\n");
+
+    ArbitraryInt *seven = create_arbitrary_int("7");
+    ArbitraryInt *exponent = create_arbitrary_int("5000");
+    ArbitraryInt *num = power(seven, exponent);
+    char *result = to_base(num, 7);
+    assert(result != NULL && strlen(result) == 5001);
+    assert(result[0] == '1' && strspn(result + 1, "0") == 5000);
+    free(result);
+    free_arbitrary_int(num);
+    free_arbitrary_int(exponent);
+
+    ArbitraryInt *sixteen = create_arbitrary_int("16");
+    ArbitraryInt *one = create_arbitrary_int("1");
+    exponent = create_arbitrary_int("4000");
+    ArbitraryInt *top = power(sixteen, exponent);
+    num = subtract(one, top);
+    result = to_base(num, 16);
+    assert(result != NULL && strlen(result) == 4001);
+    assert(result[0] == '-' && strspn(result + 1, "F") == 4000);
+    free(result);
+
+    char *decimal = arbitrary_int_to_string(top);
+    result = to_base(top, 10);
+    assert(result != NULL && strcmp(result, decimal) == 0);
+    free(result);
+    free(decimal);
+
+    free_arbitrary_int(num);
+    free_arbitrary_int(top);
+    free_arbitrary_int(exponent);
+    free_arbitrary_int(one);
+    free_arbitrary_int(sixteen);
+    free_arbitrary_int(seven);
+
+    printf("Large to_base tests passed!\n");
+}
+
+/**
+ * @brief Tests from_base on strings long enough for divide and conquer
+ *
+ * Verifies:
+ * - "1" followed by 5000 zeros in base 7 is 7^5000
+ * - 6000 random hex digits survive a from_base/to_base roundtrip
+ */
+void test_large_from_base() {
+    printf("Testing large from_base conversions...\n");
+
+    char *digits = malloc(6001);
+    digits[0] = '1';
+    memset(digits + 1, '0', 5000);
+    digits[5001] = '\0';
+
+    ArbitraryInt *seven = create_arbitrary_int("7");
+    ArbitraryInt *exponent = create_arbitrary_int("5000");
+    ArbitraryInt *expected = power(seven, exponent);
+    ArbitraryInt *num = from_base(digits, 7);
+    assert(num != NULL && compare_arbitrary_ints(num, expected) == 0);
+    free_arbitrary_int(num);
+
+    srand(42);
+    digits[0] = '-';
+    digits[1] = 'C';
+    for(int i = 2; i < 6000; i++) {
+        digits[i] = "0123456789ABCDEF"[rand() % 16];
+    }
+    digits[6000] = '\0';
+    num = from_base(digits, 16);
+    assert(num != NULL && num->is_negative);
+    char *back = to_base(num, 16);
+    assert(back != NULL && strcmp(back, digits) == 0);
+
+    free(back);
+    free(digits);
+    free_arbitrary_int(num);
+    free_arbitrary_int(expected);
+    free_arbitrary_int(exponent);
+    free_arbitrary_int(seven);
+
+    printf("Large from_base tests passed!\n");
+}
+
+/**
+ * @brief Tests power-of-two bases on a value spanning many limbs
+ *
+ * Verifies with 2^4001 - 1, whose digits straddle limb boundaries in
+ * bases 8 and 32:
+ * - Base 8 is "3" then 1333 sevens, base 32 is "1" then 800 V digits
+ * - Base 2 and base 8 strings parse back to the same value
+ */
+void test_power_of_two_bases() {
+    printf("Testing power-of-two bases...\n");
+
+    ArbitraryInt *two = create_arbitrary_int("2");
+    ArbitraryInt *one = create_arbitrary_int("1");
+    ArbitraryInt *exponent = create_arbitrary_int("4001");
+    ArbitraryInt *top = power(two, exponent);
+    ArbitraryInt *num = subtract(top, one);
+
+    char *octal = to_base(num, 8);
+    assert(octal != NULL && strlen(octal) == 1334);
+    assert(octal[0] == '3' && strspn(octal + 1, "7") == 1333);
+
+    char *base32 = to_base(num, 32);
+    assert(base32 != NULL && strlen(base32) == 801);
+    assert(base32[0] == '1' && strspn(base32 + 1, "V") == 800);
+
+    char *binary = to_base(num, 2);
+    assert(binary != NULL && strlen(binary) == 4001 && strspn(binary, "1") == 4001);
+
+    ArbitraryInt *back = from_base(binary, 2);
+    assert(back != NULL && compare_arbitrary_ints(back, num) == 0);
+    free_arbitrary_int(back);
+    back = from_base(octal, 8);
+    assert(back != NULL && compare_arbitrary_ints(back, num) == 0);
+    free_arbitrary_int(back);
+
+    free(octal);
+    free(base32);
+    free(binary);
+    free_arbitrary_int(num);
+    free_arbitrary_int(top);
+    free_arbitrary_int(exponent);
+    free_arbitrary_int(one);
+    free_arbitrary_int(two);
+
+    printf("Power-of-two base tests passed!\n");
+}
+
 int main() {
     printf("Starting base conversion tests...\n\n");
     
@@ -183,6 +355,9 @@ int main() {
     test_invalid_inputs();
     test_arbitrary_bases();
     test_base_roundtrip();
+    test_large_to_base();
+    test_large_from_base();
+    test_power_of_two_bases();
     
     printf("\nAll base conversion tests passed successfully!\n");
     return 0;
@@ -14,8 +14,22 @@
 #include <assert.h>
 #include <string.h>
 #include "../include/fraction.h"
+#include "../include/operations.h"
 #include "../include/parser.h"
 
+/**
+ * @brief Checks the decimal digits of a number's magnitude
+ * @param num Number to check
+ * @param digits Expected digits without sign
+ * @return true if |num| prints as digits
+ */
+static bool has_value(const ArbitraryInt *num, const char *digits) {
+    char *str = arbitrary_int_to_string(num);
+    bool equal = str && strcmp(str + (str[0] == '-'), digits) == 0;
+    free(str);
+    return equal;
+}
+
 /**
  * @brief Tests fraction creation and basic properties
  * 
@@ -31,8 +45,8 @@ void test_fraction_creation() {
     ArbitraryInt *den = create_arbitrary_int("2");
     Fraction *frac = create_fraction(num, den);
     
-    assert(strcmp(frac->numerator->value, "1") == 0);
-    assert(strcmp(frac->denominator->value, "2") == 0);
+    assert(has_value(frac->numerator, "1"));
+    assert(has_value(frac->denominator, "2"));
     
     free_fraction(frac);
     free_arbitrary_int(num);
@@ -57,12 +71,39 @@ void test_fraction_simplification() {
     ArbitraryInt *den = create_arbitrary_int("4");
     Fraction *frac = create_fraction(num, den);
     
-    assert(strcmp(frac->numerator->value, "1") == 0);
-    assert(strcmp(frac->denominator->value, "2") == 0);
+    assert(has_value(frac->numerator, "1"));
+    assert(has_value(frac->denominator, "2"));
     
     free_fraction(frac);
     free_arbitrary_int(num);
     free_arbitrary_int(den);
+
+    // c*F(n) / -c*F(n-1) = -F(n)/F(n-1): consecutive Fibonacci numbers are
+    // the longest Euclidean chains, and c adds a multi-limb common factor
+    ArbitraryInt *prev = create_arbitrary_int("1");
+    ArbitraryInt *fib = create_arbitrary_int("1");
+    for(int i = 0; i < 3000; i++) {
+        ArbitraryInt *next = add(fib, prev);
+        free_arbitrary_int(prev);
+        prev = fib;
+        fib = next;
+    }
+    ArbitraryInt *common = create_arbitrary_int("340282366920938463463374607431768211507");
+    num = multiply(fib, common);
+    den = multiply(prev, common);
+    den->is_negative = true;
+    frac = create_fraction(num, den);
+
+    assert(compare_arbitrary_int_magnitudes(frac->numerator, fib) == 0);
+    assert(frac->numerator->is_negative);
+    assert(compare_arbitrary_ints(frac->denominator, prev) == 0);
+
+    free_fraction(frac);
+    free_arbitrary_int(num);
+    free_arbitrary_int(den);
+    free_arbitrary_int(common);
+    free_arbitrary_int(fib);
+    free_arbitrary_int(prev);
     
     printf("Fraction simplification tests passed!\n");
 }
@@ -83,8 +124,8 @@ void test_fraction_addition() {
     Fraction *f2 = parse_fraction("1/12");
     
     Fraction *sum = add_fractions(f1, f2);
-    assert(strcmp(sum->numerator->value, "7") == 0);
-    assert(strcmp(sum->denominator->value, "12") == 0);
+    assert(has_value(sum->numerator, "7"));
+    assert(has_value(sum->denominator, "12"));
     
     free_fraction(f1);
     free_fraction(f2);
@@ -95,13 +136,30 @@ void test_fraction_addition() {
     f2 = parse_fraction("1/2");
     
     sum = add_fractions(f1, f2);
-    assert(strcmp(sum->numerator->value, "5") == 0);
-    assert(strcmp(sum->denominator->value, "4") == 0);
+    assert(has_value(sum->numerator, "5"));
+    assert(has_value(sum->denominator, "4"));
     
     free_fraction(f1);
     free_fraction(f2);
     free_fraction(sum);
     
+    // Equal denominators: 1/6 + 1/6 = 1/3 and 1/6 + -1/6 = 0/1
+    f1 = parse_fraction("1/6");
+    f2 = parse_fraction("-1/6");
+
+    sum = add_fractions(f1, f1);
+    assert(has_value(sum->numerator, "1"));
+    assert(has_value(sum->denominator, "3"));
+    free_fraction(sum);
+
+    sum = add_fractions(f1, f2);
+    assert(is_arbitrary_int_zero(sum->numerator));
+    assert(has_value(sum->denominator, "1"));
+
+    free_fraction(f1);
+    free_fraction(f2);
+    free_fraction(sum);
+    
     printf("Fraction addition tests passed!\n");
 }
 
@@ -110,6 +168,7 @@ void test_fraction_addition() {
  * 
  * Tests:
  * - Basic multiplication with simplification (2/3 * 3/4 = 1/2)
+ * - Cross cancellation with signs (6/35 * -14/9 = -4/15)
  * - Memory handling during multiplication
  */
 void test_fraction_multiplication() {
@@ -120,13 +179,25 @@ void test_fraction_multiplication() {
     Fraction *f2 = parse_fraction("3/4");
     
     Fraction *prod = multiply_fractions(f1, f2);
-    assert(strcmp(prod->numerator->value, "1") == 0);
-    assert(strcmp(prod->denominator->value, "2") == 0);
+    assert(has_value(prod->numerator, "1"));
+    assert(has_value(prod->denominator, "2"));
     
     free_fraction(f1);
     free_fraction(f2);
     free_fraction(prod);
     
+    // Test 6/35 * -14/9 = -4/15
+    f1 = parse_fraction("6/35");
+    f2 = parse_fraction("-14/9");
+
+    prod = multiply_fractions(f1, f2);
+    assert(has_value(prod->numerator, "4") && prod->numerator->is_negative);
+    assert(has_value(prod->denominator, "15") && !prod->denominator->is_negative);
+
+    free_fraction(f1);
+    free_fraction(f2);
+    free_fraction(prod);
+    
     printf("Fraction multiplication tests passed!\n");
 }
 
@@ -135,6 +206,7 @@ void test_fraction_multiplication() {
  * 
  * Tests:
  * - Basic division (3/4 / 1/2 = 3/2)
+ * - Division by a negative fraction (6/35 / -9/14 = -4/15)
  * - Memory management
  * - Result simplification
  */
@@ -146,13 +218,25 @@ void test_fraction_division() {
     Fraction *f2 = parse_fraction("1/2");
     
     Fraction *quot = divide_fractions(f1, f2);
-    assert(strcmp(quot->numerator->value, "3") == 0);
-    assert(strcmp(quot->denominator->value, "2") == 0);
+    assert(has_value(quot->numerator, "3"));
+    assert(has_value(quot->denominator, "2"));
     
     free_fraction(f1);
     free_fraction(f2);
     free_fraction(quot);
     
+    // Test 6/35 / -9/14 = -4/15
+    f1 = parse_fraction("6/35");
+    f2 = parse_fraction("-9/14");
+
+    quot = divide_fractions(f1, f2);
+    assert(has_value(quot->numerator, "4") && quot->numerator->is_negative);
+    assert(has_value(quot->denominator, "15") && !quot->denominator->is_negative);
+
+    free_fraction(f1);
+    free_fraction(f2);
+    free_fraction(quot);
+    
     printf("Fraction division tests passed!\n");
 }
 
@@ -172,8 +256,8 @@ void test_fraction_subtraction() {
     Fraction *f2 = parse_fraction("1/3");
     
     Fraction *diff = subtract_fractions(f1, f2);
-    assert(strcmp(diff->numerator->value, "1") == 0);
-    assert(strcmp(diff->denominator->value, "6") == 0);
+    assert(has_value(diff->numerator, "1"));
+    assert(has_value(diff->denominator, "6"));
     
     free_fraction(f1);
     free_fraction(f2);
@@ -182,6 +266,177 @@ void test_fraction_subtraction() {
     printf("Fraction subtraction tests passed!\n");
 }
 
+/**
+ * @brief Tests lazy fractions and comparison
+ *
+ * Tests:
+ * - Lazy creation keeps 2/4 unreduced until normalize_fraction()
+ * - A lazy harmonic sum stays within its growth bound and matches the
+ *   eager sum once normalized
+ * - compare_fractions() on reduced and unreduced values
+ */
+void test_lazy_fractions() {
+    printf("Testing lazy fractions...\n");
+
+    ArbitraryInt *two = create_arbitrary_int("2");
+    ArbitraryInt *four = create_arbitrary_int("-4");
+    Fraction *lazy = create_fraction_lazy(two, four);
+    Fraction *half = parse_fraction("-1/2");
+    assert(has_value(lazy->numerator, "2") && lazy->numerator->is_negative);
+    assert(has_value(lazy->denominator, "4") && !lazy->denominator->is_negative);
+    assert(!lazy->reduced && half->reduced);
+    assert(compare_fractions(lazy, half) == 0);
+
+    assert(normalize_fraction(lazy));
+    assert(has_value(lazy->numerator, "1") && lazy->numerator->is_negative);
+    assert(has_value(lazy->denominator, "2"));
+    free_fraction(lazy);
+    free_arbitrary_int(two);
+    free_arbitrary_int(four);
+
+    // H(n) = 1 + 1/2 + ... + 1/n, summed eagerly and lazily
+    ArbitraryInt *one = create_arbitrary_int("1");
+    Fraction *eager = create_fraction(one, one);
+    lazy = create_fraction_lazy(one, one);
+    for(int k = 2; k <= 600; k++) {
+        char digits[16];
+        snprintf(digits, sizeof(digits), "%d", k);
+        ArbitraryInt *den = create_arbitrary_int(digits);
+        Fraction *term = create_fraction(one, den);
+
+        Fraction *next = add_fractions(eager, term);
+        free_fraction(eager);
+        eager = next;
+        next = add_fractions(lazy, term);
+        free_fraction(lazy);
+        lazy = next;
+        assert(lazy->lazy && !eager->lazy);
+        assert(lazy->numerator->size + lazy->denominator->size <=
+               2 * lazy->reduced_limbs + FRACTION_LAZY_SLACK_LIMBS);
+
+        free_fraction(term);
+        free_arbitrary_int(den);
+    }
+    assert(compare_fractions(lazy, eager) == 0);
+    assert(compare_fractions(half, lazy) < 0 && compare_fractions(lazy, half) > 0);
+    assert(normalize_fraction(lazy));
+    assert(compare_arbitrary_ints(lazy->numerator, eager->numerator) == 0);
+    assert(compare_arbitrary_ints(lazy->denominator, eager->denominator) == 0);
+
+    // half is -1/2, so subtracting it moves up and adding it moves down
+    Fraction *above = subtract_fractions(eager, half);
+    Fraction *below = add_fractions(eager, half);
+    assert(compare_fractions(above, eager) > 0 && compare_fractions(eager, above) < 0);
+    assert(compare_fractions(below, eager) < 0);
+
+    free_fraction(above);
+    free_fraction(below);
+    free_fraction(eager);
+    free_fraction(lazy);
+    free_fraction(half);
+    free_arbitrary_int(one);
+
+    printf("Lazy fraction tests passed!\n");
+}
+
+/**
+ * @brief Series term 1/k for harmonic numbers
+ */
+static bool harmonic_term(uint64_t k, ArbitraryInt **p, ArbitraryInt **q, void *context) {
+    (void)context;
+    *p = create_arbitrary_int_from_uint(1);
+    *q = create_arbitrary_int_from_uint(k);
+    return true;
+}
+
+/**
+ * @brief Ratio x/k between consecutive terms of exp(x), with term 0 = 1
+ */
+static bool exp_ratio(uint64_t k, ArbitraryInt **p, ArbitraryInt **q, void *context) {
+    const Fraction *x = context;
+    if (k == 0) {
+        *p = create_arbitrary_int_from_uint(1);
+        *q = create_arbitrary_int_from_uint(1);
+        return true;
+    }
+
+    ArbitraryInt *index = create_arbitrary_int_from_uint(k);
+    *p = copy_arbitrary_int(x->numerator);
+    *q = multiply(x->denominator, index);
+    free_arbitrary_int(index);
+    return true;
+}
+
+/**
+ * @brief Tests binary-splitting series sums
+ *
+ * Tests:
+ * - Empty ranges sum to 0/1
+ * - H(2000) from sum_series() matches term-by-term addition
+ * - The Taylor partial sum of exp(-2/3) from sum_ratio_series() matches
+ *   term-by-term addition of x^k/k!
+ */
+void test_series_sums() {
+    printf("Testing series sums...\n");
+
+    Fraction *empty = sum_series(harmonic_term, NULL, 5, 5);
+    assert(is_arbitrary_int_zero(empty->numerator));
+    assert(has_value(empty->denominator, "1"));
+    free_fraction(empty);
+
+    ArbitraryInt *one = create_arbitrary_int("1");
+    Fraction *expected = create_fraction_lazy(one, one);
+    for(uint64_t k = 2; k <= 2000; k++) {
+        ArbitraryInt *p;
+        ArbitraryInt *q;
+        harmonic_term(k, &p, &q, NULL);
+        Fraction *term = create_fraction(p, q);
+        Fraction *next = add_fractions(expected, term);
+        free_fraction(expected);
+        free_fraction(term);
+        free_arbitrary_int(p);
+        free_arbitrary_int(q);
+        expected = next;
+    }
+    assert(normalize_fraction(expected));
+
+    Fraction *sum = sum_series(harmonic_term, NULL, 1, 2001);
+    assert(compare_arbitrary_ints(sum->numerator, expected->numerator) == 0);
+    assert(compare_arbitrary_ints(sum->denominator, expected->denominator) == 0);
+    free_fraction(sum);
+    free_fraction(expected);
+
+    // sum of x^k/k! for k < 300 with x = -2/3
+    Fraction *x = parse_fraction("-2/3");
+    Fraction *power = create_fraction(one, one);
+    expected = create_fraction(one, one);
+    for(uint64_t k = 1; k < 300; k++) {
+        ArbitraryInt *index = create_arbitrary_int_from_uint(k);
+        Fraction *step = create_fraction(one, index);
+        Fraction *scaled = multiply_fractions(power, x);
+        free_fraction(power);
+        power = multiply_fractions(scaled, step);
+        Fraction *next = add_fractions(expected, power);
+        free_fraction(expected);
+        expected = next;
+        free_fraction(scaled);
+        free_fraction(step);
+        free_arbitrary_int(index);
+    }
+
+    sum = sum_ratio_series(exp_ratio, x, 0, 300);
+    assert(compare_arbitrary_ints(sum->numerator, expected->numerator) == 0);
+    assert(compare_arbitrary_ints(sum->denominator, expected->denominator) == 0);
+
+    free_fraction(sum);
+    free_fraction(expected);
+    free_fraction(power);
+    free_fraction(x);
+    free_arbitrary_int(one);
+
+    printf("Series sum tests passed!\n");
+}
+
 /**
  * @brief Main test runner
  * 
@@ -201,6 +456,8 @@ int main() {
     test_fraction_multiplication();
     test_fraction_division();
     test_fraction_subtraction();
+    test_lazy_fractions();
+    test_series_sums();
     
     printf("\nAll fraction tests passed successfully!\n");
     return 0;
@@ -14,6 +14,30 @@
 #include <string.h>
 #include "../include/operations.h"
 
+/**
+ * @brief Checks the decimal digits of a number's magnitude
+ * @param num Number to check
+ * @param digits Expected digits without sign
+ * @return true if |num| prints as digits
+ */
+static bool has_value(const ArbitraryInt *num, const char *digits) {
+    char *str = arbitrary_int_to_string(num);
+    bool equal = str && strcmp(str + (str[0] == '-'), digits) == 0;
+    free(str);
+    return equal;
+}
+
+/**
+ * @brief Builds a string of count copies of digit followed by tail
+ */
+static char* repeat_digit(char digit, size_t count, const char *tail) {
+    size_t tail_len = strlen(tail);
+    char *str = malloc(count + tail_len + 1);
+    memset(str, digit, count);
+    memcpy(str + count, tail, tail_len + 1);
+    return str;
+}
+
 /**
  * @brief Tests basic arithmetic operations
  * 
@@ -31,13 +55,13 @@ void test_basic_arithmetic() {
     a = create_arbitrary_int("123456789");
     b = create_arbitrary_int("987654321");
     result = add(a, b);
-    assert(strcmp(result->value, "1111111110") == 0);
+    assert(has_value(result, "1111111110"));
     free_arbitrary_int(result);
     
     // Test negative numbers
     a->is_negative = true;
     result = add(a, b);
-    assert(strcmp(result->value, "864197532") == 0);
+    assert(has_value(result, "864197532"));
     assert(result->is_negative == false);
     free_arbitrary_int(result);
     free_arbitrary_int(a);
@@ -48,13 +72,13 @@ void test_basic_arithmetic() {
     a = create_arbitrary_int("12345");
     b = create_arbitrary_int("98765");
     result = multiply(a, b);
-    assert(strcmp(result->value, "1219253925") == 0);
+    assert(has_value(result, "1219253925"));
     free_arbitrary_int(result);
     
     // Test multiplication by zero
     b = create_arbitrary_int("0");
     result = multiply(a, b);
-    assert(strcmp(result->value, "0") == 0);
+    assert(has_value(result, "0"));
     free_arbitrary_int(result);
     free_arbitrary_int(a);
     free_arbitrary_int(b);
@@ -79,8 +103,8 @@ void test_division_and_modulo() {
     ArbitraryInt *b = create_arbitrary_int("3");
     ArbitraryInt *remainder = NULL;
     ArbitraryInt *quotient = divide(a, b, &remainder);
-    assert(strcmp(quotient->value, "333") == 0);
-    assert(strcmp(remainder->value, "1") == 0);
+    assert(has_value(quotient, "333"));
+    assert(has_value(remainder, "1"));
     free_arbitrary_int(quotient);
     free_arbitrary_int(remainder);
     
@@ -115,16 +139,76 @@ void test_division_and_modulo() {
     a = create_arbitrary_int("7");
     b = create_arbitrary_int("3");
     ArbitraryInt *mod_result = modulo(a, b);
-    assert(strcmp(mod_result->value, "1") == 0);
+    assert(has_value(mod_result, "1"));
     free_arbitrary_int(mod_result);
     
     // Test large number modulo
     free_arbitrary_int(a);
     a = create_arbitrary_int("1000000");
     mod_result = modulo(a, b);
-    assert(strcmp(mod_result->value, "1") == 0);
+    assert(has_value(mod_result, "1"));
     free_arbitrary_int(mod_result);
     
+    // 40-digit dividend by a single limb, with a negative dividend
+    free_arbitrary_int(a);
+    free_arbitrary_int(b);
+    a = create_arbitrary_int("-1234567890123456789012345678901234567890");
+    b = create_arbitrary_int("7");
+    quotient = divide(a, b, &remainder);
+    assert(quotient->is_negative);
+    assert(has_value(quotient, "176366841446208112716049382700176366841"));
+    assert(has_value(remainder, "3"));
+    free_arbitrary_int(quotient);
+    free_arbitrary_int(remainder);
+
+    // Multi-limb divisor: (10^n - 1)^2 + 12345 = (10^n - 1) * (10^n - 1) + 12345
+    free_arbitrary_int(a);
+    free_arbitrary_int(b);
+    char *nines = repeat_digit('9', 3000, "");
+    char *square = repeat_digit('9', 2999, "8");
+    char *zeros = repeat_digit('0', 2995, "12346");
+    square = realloc(square, 6001);
+    strcat(square, zeros);
+    a = create_arbitrary_int(square);
+    b = create_arbitrary_int(nines);
+    quotient = divide(a, b, &remainder);
+    assert(compare_arbitrary_ints(quotient, b) == 0);
+    assert(has_value(remainder, "12345"));
+    free_arbitrary_int(quotient);
+    free_arbitrary_int(remainder);
+    free(nines);
+    free(square);
+    free(zeros);
+
+    // Divisors large enough for recursive and Newton division: (x*y + z) / y
+    size_t lengths[] = {3000, 40000};
+    for(size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); i++) {
+        size_t n = lengths[i];
+        char *x_str = repeat_digit('7', n, "3");
+        char *y_str = repeat_digit('9', n - 1, "41");
+        char *z_str = repeat_digit('5', n - 2, "");
+        ArbitraryInt *x = create_arbitrary_int(x_str);
+        ArbitraryInt *y = create_arbitrary_int(y_str);
+        ArbitraryInt *z = create_arbitrary_int(z_str);
+        ArbitraryInt *xy = multiply(x, y);
+        ArbitraryInt *dividend = add(xy, z);
+
+        quotient = divide(dividend, y, &remainder);
+        assert(compare_arbitrary_ints(quotient, x) == 0);
+        assert(compare_arbitrary_ints(remainder, z) == 0);
+
+        free_arbitrary_int(quotient);
+        free_arbitrary_int(remainder);
+        free_arbitrary_int(dividend);
+        free_arbitrary_int(xy);
+        free_arbitrary_int(x);
+        free_arbitrary_int(y);
+        free_arbitrary_int(z);
+        free(x_str);
+        free(y_str);
+        free(z_str);
+    }
+
     free_arbitrary_int(a);
     free_arbitrary_int(b);
     
@@ -140,7 +224,7 @@ void test_power() {
     base = create_arbitrary_int("2");
     exp = create_arbitrary_int("10");
     result = power(base, exp);
-    assert(strcmp(result->value, "1024") == 0);
+    assert(has_value(result, "1024"));
     free_arbitrary_int(result);
     
     // Test negative exponent (should return NULL)
@@ -154,10 +238,51 @@ void test_power() {
     base = create_arbitrary_int("0");
     exp = create_arbitrary_int("0");
     result = power(base, exp);
-    assert(strcmp(result->value, "1") == 0);
+    assert(has_value(result, "1"));
     free_arbitrary_int(result);
     free_arbitrary_int(base);
     free_arbitrary_int(exp);
+
+    // Sliding window and the shift fast paths for powers of two and ten
+    const char *cases[][3] = {
+        {"2", "100", "1267650600228229401496703205376"},
+        {"-10", "3", "-1000"},
+        {"12", "30", "237376313799769806328950291431424"},
+        {"7", "77", "118181386580595879976868414312001964434038548836769923458287039207"},
+        {"0", "5", "0"},
+        {"1", "1000000000000000000000000000000", "1"},
+        {"-1", "1000000000000000000000000000001", "-1"}
+    };
+    for(size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+        base = create_arbitrary_int(cases[i][0]);
+        exp = create_arbitrary_int(cases[i][1]);
+        result = power(base, exp);
+        char *str = arbitrary_int_to_string(result);
+        assert(strcmp(str, cases[i][2]) == 0);
+        free(str);
+        free_arbitrary_int(result);
+        free_arbitrary_int(base);
+        free_arbitrary_int(exp);
+    }
+
+    // Large exponents: 3^(m+n) = 3^m * 3^n
+    base = create_arbitrary_int("3");
+    ArbitraryInt *m = create_arbitrary_int("40000");
+    ArbitraryInt *n = create_arbitrary_int("25001");
+    ArbitraryInt *m_plus_n = add(m, n);
+    ArbitraryInt *pm = power(base, m);
+    ArbitraryInt *pn = power(base, n);
+    ArbitraryInt *product = multiply(pm, pn);
+    result = power(base, m_plus_n);
+    assert(compare_arbitrary_ints(result, product) == 0);
+    free_arbitrary_int(result);
+    free_arbitrary_int(product);
+    free_arbitrary_int(pm);
+    free_arbitrary_int(pn);
+    free_arbitrary_int(m_plus_n);
+    free_arbitrary_int(m);
+    free_arbitrary_int(n);
+    free_arbitrary_int(base);
     
     printf("Power function tests passed!\n");
 }
@@ -170,17 +295,44 @@ void test_factorial() {
     // Test 5!
     n = create_arbitrary_int("5");
     result = factorial(n);
-    assert(strcmp(result->value, "120") == 0);
+    assert(has_value(result, "120"));
     free_arbitrary_int(result);
     
     // Test 0!
     free_arbitrary_int(n);
     n = create_arbitrary_int("0");
     result = factorial(n);
-    assert(strcmp(result->value, "1") == 0);
+    assert(has_value(result, "1"));
     free_arbitrary_int(result);
     
+    // Test 25!, past the single-limb range
+    free_arbitrary_int(n);
+    n = create_arbitrary_int("25");
+    result = factorial(n);
+    assert(has_value(result, "15511210043330985984000000"));
+    free_arbitrary_int(result);
+
+    // n! = n * (n-1)! across many prime-swing levels
+    const char *sizes[] = {"1023", "1024", "20001"};
+    for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+        ArbitraryInt *m = create_arbitrary_int(sizes[i]);
+        ArbitraryInt *one = create_arbitrary_int("1");
+        ArbitraryInt *m_minus_1 = subtract(m, one);
+        ArbitraryInt *lhs = factorial(m);
+        ArbitraryInt *prev = factorial(m_minus_1);
+        ArbitraryInt *rhs = multiply(m, prev);
+        assert(compare_arbitrary_ints(lhs, rhs) == 0);
+        free_arbitrary_int(rhs);
+        free_arbitrary_int(prev);
+        free_arbitrary_int(lhs);
+        free_arbitrary_int(m_minus_1);
+        free_arbitrary_int(one);
+        free_arbitrary_int(m);
+    }
+
     // Test negative number (should return NULL)
+    free_arbitrary_int(n);
+    n = create_arbitrary_int("0");
     n->is_negative = true;
     result = factorial(n);
     assert(result == NULL);
@@ -198,7 +350,7 @@ void test_logarithm() {
     num = create_arbitrary_int("8");
     base = create_arbitrary_int("2");
     result = logarithm(num, base);
-    assert(strcmp(result->value, "3") == 0);
+    assert(has_value(result, "3"));
     free_arbitrary_int(result);
     
     // Test log10(1000) = 3
@@ -207,7 +359,7 @@ void test_logarithm() {
     num = create_arbitrary_int("1000");
     base = create_arbitrary_int("10");
     result = logarithm(num, base);
-    assert(strcmp(result->value, "3") == 0);
+    assert(has_value(result, "3"));
     free_arbitrary_int(result);
     
     // Test error cases
@@ -245,18 +397,18 @@ void test_edge_cases() {
     a = create_arbitrary_int("999999999999999999999999999999");
     b = create_arbitrary_int("1");
     result = add(a, b);
-    assert(strcmp(result->value, "1000000000000000000000000000000") == 0);
+    assert(has_value(result, "1000000000000000000000000000000"));
     free_arbitrary_int(result);
     
     // Test operations with zero
     result = multiply(a, b);
-    assert(strcmp(result->value, "999999999999999999999999999999") == 0);
+    assert(has_value(result, "999999999999999999999999999999"));
     free_arbitrary_int(result);
     
     free_arbitrary_int(b);
     b = create_arbitrary_int("0");
     result = add(a, b);
-    assert(strcmp(result->value, "999999999999999999999999999999") == 0);
+    assert(has_value(result, "999999999999999999999999999999"));
     free_arbitrary_int(result);
     
     free_arbitrary_int(a);
@@ -282,7 +434,7 @@ void test_logarithm_comprehensive() {
         ArbitraryInt *result = logarithm(nums[i], base);
         char expected[2];
         sprintf(expected, "%d", i + 1);
-        assert(strcmp(result->value, expected) == 0);
+        assert(has_value(result, expected));
         free_arbitrary_int(result);
     }
     
@@ -295,11 +447,42 @@ void test_logarithm_comprehensive() {
     base = create_arbitrary_int("10");
     ArbitraryInt *num = create_arbitrary_int("1000000");
     ArbitraryInt *result = logarithm(num, base);
-    assert(strcmp(result->value, "6") == 0);
+    assert(has_value(result, "6"));
     
     free_arbitrary_int(base);
     free_arbitrary_int(num);
     free_arbitrary_int(result);
+
+    // b^k - 1, b^k and b^k + 1 sit right at the estimate's blind spot
+    const char *bases[] = {"2", "3", "10", "20", "1000", "18446744073709551617"};
+    const char *exponents[] = {"200000", "5000", "30000", "700", "333", "50"};
+    ArbitraryInt *one = create_arbitrary_int("1");
+    for(size_t i = 0; i < sizeof(bases)/sizeof(bases[0]); i++) {
+        base = create_arbitrary_int(bases[i]);
+        ArbitraryInt *k = create_arbitrary_int(exponents[i]);
+        ArbitraryInt *k_minus_1 = subtract(k, one);
+        ArbitraryInt *exact = power(base, k);
+        ArbitraryInt *below = subtract(exact, one);
+        ArbitraryInt *above = add(exact, one);
+
+        result = logarithm(below, base);
+        assert(compare_arbitrary_ints(result, k_minus_1) == 0);
+        free_arbitrary_int(result);
+        result = logarithm(exact, base);
+        assert(compare_arbitrary_ints(result, k) == 0);
+        free_arbitrary_int(result);
+        result = logarithm(above, base);
+        assert(compare_arbitrary_ints(result, k) == 0);
+        free_arbitrary_int(result);
+
+        free_arbitrary_int(above);
+        free_arbitrary_int(below);
+        free_arbitrary_int(exact);
+        free_arbitrary_int(k_minus_1);
+        free_arbitrary_int(k);
+        free_arbitrary_int(base);
+    }
+    free_arbitrary_int(one);
     
     printf("Comprehensive logarithm tests passed!\n");
 }
@@ -332,6 +515,282 @@ void test_logarithm_errors() {
     printf("Logarithm error case tests passed!\n");
 }
 
+/**
+ * @brief Tests multiplication above the Karatsuba and Toom thresholds
+ *
+ * Verifies:
+ * - (10^n - 1)^2 = 99..9800..01 for balanced operands
+ * - a*(b+c) = a*b + a*c for unbalanced operands
+ * - Commutativity of large products
+ */
+void test_large_multiplication() {
+    printf("Testing large multiplication...\n");
+
+    // (10^n - 1)^2 = 9{n-1} 8 0{n-1} 1, sized for Karatsuba, Toom-3, Toom-4 and NTT
+    size_t lengths[] = {3000, 8000, 40000, 320000};
+    for(size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); i++) {
+        size_t n = lengths[i];
+        char *nines = repeat_digit('9', n, "");
+        char *zeros = repeat_digit('0', n - 1, "1");
+        char *expected = repeat_digit('9', n - 1, "8");
+        expected = realloc(expected, 2 * n + 1);
+        strcat(expected, zeros);
+
+        ArbitraryInt *a = create_arbitrary_int(nines);
+        ArbitraryInt *result = multiply(a, a);
+        assert(has_value(result, expected));
+        free_arbitrary_int(result);
+        free_arbitrary_int(a);
+        free(nines);
+        free(zeros);
+        free(expected);
+    }
+
+    // Unbalanced operands: a*(b+c) = a*b + a*c
+    char *a_str = repeat_digit('7', 6000, "123");
+    char *b_str = repeat_digit('3', 1500, "9");
+    char *c_str = repeat_digit('8', 2500, "1");
+    ArbitraryInt *a = create_arbitrary_int(a_str);
+    ArbitraryInt *b = create_arbitrary_int(b_str);
+    ArbitraryInt *c = create_arbitrary_int(c_str);
+    c->is_negative = true;
+
+    ArbitraryInt *b_plus_c = add(b, c);
+    ArbitraryInt *lhs = multiply(a, b_plus_c);
+    ArbitraryInt *ab = multiply(a, b);
+    ArbitraryInt *ac = multiply(c, a);
+    ArbitraryInt *rhs = add(ab, ac);
+    assert(compare_arbitrary_ints(lhs, rhs) == 0);
+    assert(lhs->is_negative == true);
+
+    free_arbitrary_int(b_plus_c);
+    free_arbitrary_int(lhs);
+    free_arbitrary_int(ab);
+    free_arbitrary_int(ac);
+    free_arbitrary_int(rhs);
+    free_arbitrary_int(a);
+    free_arbitrary_int(b);
+    free_arbitrary_int(c);
+    free(a_str);
+    free(b_str);
+    free(c_str);
+
+    printf("Large multiplication tests passed!\n");
+}
+
+void test_square() {
+    printf("Testing square...\n");
+
+    ArbitraryInt *zero = create_arbitrary_int("0");
+    ArbitraryInt *result = square(zero);
+    assert(has_value(result, "0"));
+    free_arbitrary_int(result);
+    free_arbitrary_int(zero);
+
+    // a*(-a) takes the squaring path but keeps the sign
+    ArbitraryInt *a = create_arbitrary_int("-123456789012345678901234567890");
+    ArbitraryInt *b = create_arbitrary_int("123456789012345678901234567890");
+    result = multiply(a, b);
+    assert(has_value(result, "15241578753238836750495351562536198787501905199875019052100"));
+    assert(result->is_negative);
+    free_arbitrary_int(result);
+    result = square(a);
+    assert(has_value(result, "15241578753238836750495351562536198787501905199875019052100"));
+    assert(!result->is_negative);
+    free_arbitrary_int(result);
+    free_arbitrary_int(a);
+    free_arbitrary_int(b);
+
+    // a^2 = (a+1)*(a-1) + 1 checks each squaring tier against the
+    // general product
+    size_t lengths[] = {500, 1500, 5000, 20000, 120000};
+    ArbitraryInt *one = create_arbitrary_int("1");
+    for(size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); i++) {
+        char *digits = repeat_digit('3', lengths[i], "1415926535");
+        a = create_arbitrary_int(digits);
+        ArbitraryInt *above = add(a, one);
+        ArbitraryInt *below = subtract(a, one);
+        ArbitraryInt *product = multiply(above, below);
+        ArbitraryInt *expected = add(product, one);
+
+        result = square(a);
+        assert(compare_arbitrary_ints(result, expected) == 0);
+
+        free_arbitrary_int(result);
+        free_arbitrary_int(expected);
+        free_arbitrary_int(product);
+        free_arbitrary_int(below);
+        free_arbitrary_int(above);
+        free_arbitrary_int(a);
+        free(digits);
+    }
+    free_arbitrary_int(one);
+}
+
+void test_gcd() {
+    printf("Testing gcd...\n");
+
+    const char *cases[][3] = {
+        {"12", "-18", "6"},
+        {"0", "-5", "5"},
+        {"0", "0", "0"},
+        {"-7", "0", "7"},
+        {"1071", "462", "21"},
+        {"340282366920938463463374607431768211457", "18446744073709551617", "1"},
+    };
+    for(size_t i = 0; i < sizeof(cases)/sizeof(cases[0]); i++) {
+        ArbitraryInt *a = create_arbitrary_int(cases[i][0]);
+        ArbitraryInt *b = create_arbitrary_int(cases[i][1]);
+        ArbitraryInt *s = NULL, *t = NULL;
+        ArbitraryInt *g = gcd(a, b);
+        assert(has_value(g, cases[i][2]) && !g->is_negative);
+        free_arbitrary_int(g);
+
+        // a*s + b*t = g
+        g = gcdext(a, b, &s, &t);
+        assert(has_value(g, cases[i][2]));
+        ArbitraryInt *as = multiply(a, s);
+        ArbitraryInt *bt = multiply(b, t);
+        ArbitraryInt *sum = add(as, bt);
+        assert(compare_arbitrary_ints(sum, g) == 0);
+        free_arbitrary_int(sum);
+        free_arbitrary_int(bt);
+        free_arbitrary_int(as);
+        free_arbitrary_int(g);
+        free_arbitrary_int(s);
+        free_arbitrary_int(t);
+        free_arbitrary_int(a);
+        free_arbitrary_int(b);
+    }
+
+    // 7^k * 3^m and -7^k * (2^e + 1) share exactly 7^k; sized to reach
+    // the half-GCD
+    const char *sizes[][3] = {{"50", "300", "400"}, {"3000", "60000", "100000"}};
+    ArbitraryInt *one = create_arbitrary_int("1");
+    ArbitraryInt *two = create_arbitrary_int("2");
+    ArbitraryInt *three = create_arbitrary_int("3");
+    ArbitraryInt *seven = create_arbitrary_int("7");
+    for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+        ArbitraryInt *k = create_arbitrary_int(sizes[i][0]);
+        ArbitraryInt *m = create_arbitrary_int(sizes[i][1]);
+        ArbitraryInt *e = create_arbitrary_int(sizes[i][2]);
+        ArbitraryInt *common = power(seven, k);
+        ArbitraryInt *x = power(three, m);
+        ArbitraryInt *y0 = power(two, e);
+        ArbitraryInt *y = add(y0, one);
+        ArbitraryInt *a = multiply(common, x);
+        ArbitraryInt *b = multiply(common, y);
+        b->is_negative = true;
+
+        ArbitraryInt *g = gcd(a, b);
+        assert(compare_arbitrary_ints(g, common) == 0);
+        free_arbitrary_int(g);
+
+        ArbitraryInt *s = NULL, *t = NULL;
+        g = gcdext(a, b, &s, &t);
+        assert(compare_arbitrary_ints(g, common) == 0);
+        assert(compare_arbitrary_int_magnitudes(s, y) <= 0);
+        assert(compare_arbitrary_int_magnitudes(t, x) <= 0);
+        ArbitraryInt *as = multiply(a, s);
+        ArbitraryInt *bt = multiply(b, t);
+        ArbitraryInt *sum = add(as, bt);
+        assert(compare_arbitrary_ints(sum, g) == 0);
+
+        free_arbitrary_int(sum);
+        free_arbitrary_int(bt);
+        free_arbitrary_int(as);
+        free_arbitrary_int(s);
+        free_arbitrary_int(t);
+        free_arbitrary_int(g);
+        free_arbitrary_int(b);
+        free_arbitrary_int(a);
+        free_arbitrary_int(y);
+        free_arbitrary_int(y0);
+        free_arbitrary_int(x);
+        free_arbitrary_int(common);
+        free_arbitrary_int(e);
+        free_arbitrary_int(m);
+        free_arbitrary_int(k);
+    }
+    free_arbitrary_int(seven);
+    free_arbitrary_int(three);
+    free_arbitrary_int(two);
+    free_arbitrary_int(one);
+}
+
+/**
+ * @brief Tests additions and subtractions with long carry chains
+ *
+ * Sized to run through the vector add/subtract kernels, with carries
+ * that ripple across every limb in both limb representations.
+ */
+void test_long_carry_chains() {
+    printf("Testing long carry chains...\n");
+
+    // (10^n - 1) + 1 = 10^n and back again
+    size_t lengths[] = {40, 401, 5000};
+    for(size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); i++) {
+        size_t n = lengths[i];
+        char *nines = repeat_digit('9', n, "");
+        char *power_of_ten = repeat_digit('0', n, "");
+        power_of_ten[0] = '1';
+        power_of_ten = realloc(power_of_ten, n + 2);
+        strcat(power_of_ten, "0");
+
+        ArbitraryInt *a = create_arbitrary_int(nines);
+        ArbitraryInt *one = create_arbitrary_int_from_uint(1);
+        ArbitraryInt *sum = add(a, one);
+        assert(has_value(sum, power_of_ten));
+        ArbitraryInt *diff = subtract(sum, one);
+        assert(has_value(diff, nines));
+
+        free_arbitrary_int(a);
+        free_arbitrary_int(one);
+        free_arbitrary_int(sum);
+        free_arbitrary_int(diff);
+        free(nines);
+        free(power_of_ten);
+    }
+
+    // (2^k - 1) + 1 = 2^k, carrying through all-ones binary limbs
+    ArbitraryInt *two = create_arbitrary_int_from_uint(2);
+    ArbitraryInt *exponent = create_arbitrary_int_from_uint(64 * 300);
+    ArbitraryInt *one = create_arbitrary_int_from_uint(1);
+    ArbitraryInt *p = power(two, exponent);
+    ArbitraryInt *below = subtract(p, one);
+    ArbitraryInt *restored = add(below, one);
+    assert(compare_arbitrary_ints(restored, p) == 0);
+    free_arbitrary_int(restored);
+
+    // (a + b) - b == a and a - (a - 1) == 1 with mixed limb patterns
+    char *a_str = repeat_digit('9', 3000, "");
+    for(size_t i = 0; i < 3000; i += 37) {
+        a_str[i] = (char)('0' + i % 10);
+    }
+    a_str[0] = '8';
+    ArbitraryInt *a = create_arbitrary_int(a_str);
+    ArbitraryInt *sum = add(a, below);
+    ArbitraryInt *back = subtract(sum, below);
+    assert(compare_arbitrary_ints(back, a) == 0);
+    ArbitraryInt *a_minus_one = subtract(a, one);
+    ArbitraryInt *unit = subtract(a, a_minus_one);
+    assert(has_value(unit, "1"));
+
+    free_arbitrary_int(two);
+    free_arbitrary_int(exponent);
+    free_arbitrary_int(one);
+    free_arbitrary_int(p);
+    free_arbitrary_int(below);
+    free_arbitrary_int(a);
+    free_arbitrary_int(sum);
+    free_arbitrary_int(back);
+    free_arbitrary_int(a_minus_one);
+    free_arbitrary_int(unit);
+    free(a_str);
+
+    printf("Long carry chain tests passed!\n");
+}
+
 int main() {
     printf("Starting tests...\n\n");
     
@@ -343,6 +802,10 @@ int main() {
     test_edge_cases();
     test_logarithm_comprehensive();
     test_logarithm_errors();
+    test_large_multiplication();
+    test_square();
+    test_gcd();
+    test_long_carry_chains();
     
     printf("\nAll tests passed successfully!\n");
     return 0;